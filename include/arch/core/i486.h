@@ -36,6 +36,8 @@
 
 	#include <arch/core/i486/8253.h>
 	#include <arch/core/i486/8259.h>
+	#include <arch/core/i486/atomic.h>
+	#include <arch/core/i486/bitops.h>
 	#include <arch/core/i486/cache.h>
 	#include <arch/core/i486/core.h>
 	#include <arch/core/i486/excp.h>
@@ -34,27 +34,70 @@
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <stdint.h>
 
 	/**
 	 * @name Provided Interface
 	 */
 	/**@{*/
-	#define __clock_init_fn
+	#define __clock_init_fn        /**< clock_init()        */
+	#define __clock_read_cycles_fn /**< clock_read_cycles() */
+	#define __clock_cycles_freq_fn /**< clock_cycles_freq() */
 	/**@}*/
 
 	/**
 	 * @brief Oscillator frequency (in Hz)
 	 */
 	#define PIT_FREQUENCY 1193182
-	
+
 	/**
 	 * @name Registers
 	 */
 	/**@{*/
-	#define PIT_CTRL 0x43 /**< Control */
-	#define PIT_DATA 0x40 /**< Data    */
+	#define PIT_CTRL  0x43 /**< Control              */
+	#define PIT_DATA  0x40 /**< Data (channel 0)     */
+	#define PIT_DATA2 0x42 /**< Data (channel 2)     */
+	#define PIT_GATE  0x61 /**< Gate (channel 2)     */
+	/**@}*/
+
+	/**
+	 * @name Bits of the Gate Register
+	 */
+	/**@{*/
+	#define PIT_GATE_ENABLE  0x01 /**< Gate input of channel 2.  */
+	#define PIT_GATE_SPEAKER 0x02 /**< Speaker data.             */
+	#define PIT_GATE_OUT     0x20 /**< Output of channel 2.      */
 	/**@}*/
 
+	/**
+	 * @brief Sets up the cycle counter.
+	 *
+	 * The i486_clock_setup() function probes for the Time-Stamp
+	 * Counter (TSC) and calibrates it against the PIT. If no TSC is
+	 * present, channel 2 of the PIT is set to run freely, so that
+	 * its count may be latched instead.
+	 */
+	EXTERN void i486_clock_setup(void);
+
+	/**
+	 * @brief Reads the cycle counter.
+	 *
+	 * @returns The number of cycles elapsed since i486_clock_setup()
+	 * was called.
+	 *
+	 * @note When no TSC is present, this function must be called at
+	 * least once every 55 ms, otherwise wraps of the PIT count are
+	 * missed.
+	 */
+	EXTERN uint64_t i486_clock_read_cycles(void);
+
+	/**
+	 * @brief Gets the frequency of the cycle counter.
+	 *
+	 * @returns The frequency of the cycle counter (in Hz).
+	 */
+	EXTERN uint32_t i486_clock_cycles_freq(void);
+
 	/**
 	 * @brief Initializes the clock driver in the i486 architecture.
 	 *
@@ -70,6 +113,22 @@
 		i486_clock_init(freq);
 	}
 
+	/**
+	 * @see i486_clock_read_cycles()
+	 */
+	static inline uint64_t clock_read_cycles(void)
+	{
+		return (i486_clock_read_cycles());
+	}
+
+	/**
+	 * @see i486_clock_cycles_freq()
+	 */
+	static inline uint32_t clock_cycles_freq(void)
+	{
+		return (i486_clock_cycles_freq());
+	}
+
 /**@}*/
 
 #endif /* ARCH_I486_8253_H_ */
@@ -0,0 +1,286 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CORE_I486_ATOMIC_H_
+#define ARCH_CORE_I486_ATOMIC_H_
+
+/**
+ * @addtogroup i486-core-atomic Atomic
+ * @ingroup i486-core
+ *
+ * @brief i486 Atomic Operations
+ *
+ * Read-modify-write operations use lock-prefixed instructions, thus
+ * they are full memory barriers as well.
+ */
+/**@{*/
+
+#ifndef _ASM_FILE_
+
+	#include <nanvix/const.h>
+	#include <stdint.h>
+
+	/**
+	 * @brief Atomically loads a word.
+	 *
+	 * @param ptr Target word.
+	 *
+	 * @returns The value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t i486_atomic_load(const volatile uint32_t *ptr)
+	{
+		return (*ptr);
+	}
+
+	/**
+	 * @brief Atomically stores a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 */
+	static inline void i486_atomic_store(volatile uint32_t *ptr, uint32_t val)
+	{
+		*ptr = val;
+	}
+
+	/**
+	 * @brief Atomically exchanges a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t i486_atomic_xchg(volatile uint32_t *ptr, uint32_t val)
+	{
+		/* xchg with memory is implicitly locked. */
+		__asm__ __volatile__
+		(
+			"xchgl %0, %1"
+			: "=r" (val),
+			  "+m" (*ptr)
+			: "0" (val)
+			: "memory"
+		);
+
+		return (val);
+	}
+
+	/**
+	 * @brief Atomically compares and swaps a word.
+	 *
+	 * @param ptr    Target word.
+	 * @param oldval Expected value.
+	 * @param newval Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr. The
+	 * swap took place if and only if it equals @p oldval.
+	 */
+	static inline uint32_t i486_atomic_cas(volatile uint32_t *ptr, uint32_t oldval, uint32_t newval)
+	{
+		uint32_t old;
+
+		__asm__ __volatile__
+		(
+			"lock; cmpxchgl %2, %1"
+			: "=a" (old),
+			  "+m" (*ptr)
+			: "r" (newval),
+			  "0" (oldval)
+			: "memory", "cc"
+		);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically adds a value to a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to add.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t i486_atomic_fetch_add(volatile uint32_t *ptr, uint32_t val)
+	{
+		__asm__ __volatile__
+		(
+			"lock; xaddl %0, %1"
+			: "=r" (val),
+			  "+m" (*ptr)
+			: "0" (val)
+			: "memory", "cc"
+		);
+
+		return (val);
+	}
+
+	/**
+	 * @brief Atomically subtracts a value from a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to subtract.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t i486_atomic_fetch_sub(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (i486_atomic_fetch_add(ptr, -val));
+	}
+
+	/**
+	 * @brief Atomically ORs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to OR.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t i486_atomic_fetch_or(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+
+		do
+			old = *ptr;
+		while (i486_atomic_cas(ptr, old, old | val) != old);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically ANDs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to AND.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t i486_atomic_fetch_and(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+
+		do
+			old = *ptr;
+		while (i486_atomic_cas(ptr, old, old & val) != old);
+
+		return (old);
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond i486
+ */
+
+	/**
+	 * @name Provided Interface
+	 */
+	/**@{*/
+	#define __atomic_load_fn      /**< atomic_load()      */
+	#define __atomic_store_fn     /**< atomic_store()     */
+	#define __atomic_xchg_fn      /**< atomic_xchg()      */
+	#define __atomic_cas_fn       /**< atomic_cas()       */
+	#define __atomic_fetch_add_fn /**< atomic_fetch_add() */
+	#define __atomic_fetch_sub_fn /**< atomic_fetch_sub() */
+	#define __atomic_fetch_or_fn  /**< atomic_fetch_or()  */
+	#define __atomic_fetch_and_fn /**< atomic_fetch_and() */
+	/**@}*/
+
+#ifndef _ASM_FILE_
+
+	/**
+	 * @see i486_atomic_load().
+	 */
+	static inline uint32_t atomic_load(const volatile uint32_t *ptr)
+	{
+		return (i486_atomic_load(ptr));
+	}
+
+	/**
+	 * @see i486_atomic_store().
+	 */
+	static inline void atomic_store(volatile uint32_t *ptr, uint32_t val)
+	{
+		i486_atomic_store(ptr, val);
+	}
+
+	/**
+	 * @see i486_atomic_xchg().
+	 */
+	static inline uint32_t atomic_xchg(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (i486_atomic_xchg(ptr, val));
+	}
+
+	/**
+	 * @see i486_atomic_cas().
+	 */
+	static inline uint32_t atomic_cas(volatile uint32_t *ptr, uint32_t oldval, uint32_t newval)
+	{
+		return (i486_atomic_cas(ptr, oldval, newval));
+	}
+
+	/**
+	 * @see i486_atomic_fetch_add().
+	 */
+	static inline uint32_t atomic_fetch_add(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (i486_atomic_fetch_add(ptr, val));
+	}
+
+	/**
+	 * @see i486_atomic_fetch_sub().
+	 */
+	static inline uint32_t atomic_fetch_sub(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (i486_atomic_fetch_sub(ptr, val));
+	}
+
+	/**
+	 * @see i486_atomic_fetch_or().
+	 */
+	static inline uint32_t atomic_fetch_or(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (i486_atomic_fetch_or(ptr, val));
+	}
+
+	/**
+	 * @see i486_atomic_fetch_and().
+	 */
+	static inline uint32_t atomic_fetch_and(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (i486_atomic_fetch_and(ptr, val));
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@endcond*/
+
+#endif /* ARCH_CORE_I486_ATOMIC_H_ */
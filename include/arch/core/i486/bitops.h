@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CORE_I486_BITOPS_H_
+#define ARCH_CORE_I486_BITOPS_H_
+
+/**
+ * @addtogroup i486-core-bitops Bit Operations
+ * @ingroup i486-core
+ *
+ * @brief i486 Bit Operations
+ */
+/**@{*/
+
+#ifndef _ASM_FILE_
+
+	#include <stdint.h>
+
+	/**
+	 * @brief Counts leading zero bits.
+	 *
+	 * @param x Target value.
+	 *
+	 * @returns The number of leading zero bits in @p x.
+	 *
+	 * @note @p x should not be zero.
+	 */
+	static inline int i486_bit_clz(uint32_t x)
+	{
+		uint32_t pos;
+
+		__asm__ ("bsrl %1, %0" : "=r"(pos) : "rm"(x));
+
+		return (31 - pos);
+	}
+
+	/**
+	 * @brief Counts trailing zero bits.
+	 *
+	 * @param x Target value.
+	 *
+	 * @returns The number of trailing zero bits in @p x.
+	 *
+	 * @note @p x should not be zero.
+	 */
+	static inline int i486_bit_ctz(uint32_t x)
+	{
+		uint32_t pos;
+
+		__asm__ ("bsfl %1, %0" : "=r"(pos) : "rm"(x));
+
+		return (pos);
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond i486
+ */
+
+	/**
+	 * @name Provided Functions
+	 */
+	/**@{*/
+	#define __bit_clz_fn /**< bit_clz() */
+	#define __bit_ctz_fn /**< bit_ctz() */
+	/**@}*/
+
+#ifndef _ASM_FILE_
+
+	/**
+	 * @see i486_bit_clz().
+	 */
+	static inline int bit_clz(uint32_t x)
+	{
+		return (i486_bit_clz(x));
+	}
+
+	/**
+	 * @see i486_bit_ctz().
+	 */
+	static inline int bit_ctz(uint32_t x)
+	{
+		return (i486_bit_ctz(x));
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@endcond*/
+
+#endif /* ARCH_CORE_I486_BITOPS_H_ */
@@ -33,11 +33,21 @@
  */
 /**@{*/
 
+	#include <stddef.h>
+
 	/**
 	 * @name Provided Interface
 	 */
 	/**@{*/
 	#define __dcache_invalidate_fn
+	#define __dcache_invalidate_range_fn
+	#define __dcache_flush_range_fn
+	#define __dcache_flush_invalidate_range_fn
+	#define __hal_mb_fn
+	#define __hal_rmb_fn
+	#define __hal_wmb_fn
+	#define __hal_acquire_fn
+	#define __hal_release_fn
 	/**@}*/
 
 	/**
@@ -59,6 +69,96 @@
 	{
 	}
 
+	/**
+	 * @note The i486 target features cache coherency.
+	 */
+	static inline void dcache_invalidate_range(const void *addr, size_t len)
+	{
+		((void) addr);
+		((void) len);
+	}
+
+	/**
+	 * @note The i486 target features cache coherency.
+	 */
+	static inline void dcache_flush_range(const void *addr, size_t len)
+	{
+		((void) addr);
+		((void) len);
+	}
+
+	/**
+	 * @note The i486 target features cache coherency.
+	 */
+	static inline void dcache_flush_invalidate_range(const void *addr, size_t len)
+	{
+		((void) addr);
+		((void) len);
+	}
+
+	/**
+	 * @brief Full memory barrier.
+	 *
+	 * The i486 has no fence instructions, but locked instructions
+	 * drain the store buffer.
+	 */
+	static inline void i486_mb(void)
+	{
+		__asm__ __volatile__ ("lock; addl $0, (%%esp)" ::: "memory", "cc");
+	}
+
+	/**
+	 * @brief Compiler barrier.
+	 *
+	 * The i486 does not reorder loads with other loads, nor stores
+	 * with other stores, so this suffices for read, write, acquire
+	 * and release barriers.
+	 */
+	static inline void i486_barrier(void)
+	{
+		__asm__ __volatile__ ("" ::: "memory");
+	}
+
+	/**
+	 * @see i486_mb().
+	 */
+	static inline void hal_mb(void)
+	{
+		i486_mb();
+	}
+
+	/**
+	 * @see i486_barrier().
+	 */
+	static inline void hal_rmb(void)
+	{
+		i486_barrier();
+	}
+
+	/**
+	 * @see i486_barrier().
+	 */
+	static inline void hal_wmb(void)
+	{
+		i486_barrier();
+	}
+
+	/**
+	 * @see i486_barrier().
+	 */
+	static inline void hal_acquire(void)
+	{
+		i486_barrier();
+	}
+
+	/**
+	 * @see i486_barrier().
+	 */
+	static inline void hal_release(void)
+	{
+		i486_barrier();
+	}
+
 /**@}*/
 
 #endif /* ARCH_I486_CACHE_H_ */
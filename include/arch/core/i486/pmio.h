@@ -47,6 +47,22 @@
 		__asm__ __volatile__ ("outb %0, %1" : : "a"(bits), "Nd"(port));
 	}
 
+	/**
+	 * @brief Reads 8 bits from an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 *
+	 * @returns The bits that were read.
+	 */
+	static inline uint8_t i486_input8(uint16_t port)
+	{
+		uint8_t bits;
+
+		__asm__ __volatile__ ("inb %1, %0" : "=a"(bits) : "Nd"(port));
+
+		return (bits);
+	}
+
 	/**
 	 * @brief Waits for an operation in an I/O port to complete.
 	 */
@@ -62,9 +78,90 @@
 	 * @param str  8-bit string to write.
 	 * @param len  Length of the string.
 	 *
-	 * @todo This can be platform-independent.
+	 * @note The whole string is moved with a single string
+	 * instruction, thus this should not be used with devices that
+	 * require pacing between consecutive accesses.
+	 *
+	 * @see i486_output8s_paced().
 	 */
 	static inline void i486_output8s(uint16_t port, const uint8_t *str, size_t len)
+	{
+		__asm__ __volatile__ (
+			"rep outsb"
+			: "+S"(str), "+c"(len)
+			: "d"(port)
+			: "memory"
+		);
+	}
+
+	/**
+	 * @brief Writes a 16-bit string to an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  16-bit string to write.
+	 * @param len  Length of the string (in 16-bit words).
+	 */
+	static inline void i486_output16s(uint16_t port, const uint16_t *str, size_t len)
+	{
+		__asm__ __volatile__ (
+			"rep outsw"
+			: "+S"(str), "+c"(len)
+			: "d"(port)
+			: "memory"
+		);
+	}
+
+	/**
+	 * @brief Writes a 32-bit string to an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  32-bit string to write.
+	 * @param len  Length of the string (in 32-bit words).
+	 */
+	static inline void i486_output32s(uint16_t port, const uint32_t *str, size_t len)
+	{
+		__asm__ __volatile__ (
+			"rep outsl"
+			: "+S"(str), "+c"(len)
+			: "d"(port)
+			: "memory"
+		);
+	}
+
+	/**
+	 * @brief Reads a 8-bit string from an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  Target 8-bit string.
+	 * @param len  Length of the string.
+	 *
+	 * @note The whole string is moved with a single string
+	 * instruction, thus this should not be used with devices that
+	 * require pacing between consecutive accesses.
+	 *
+	 * @see i486_input8s_paced().
+	 */
+	static inline void i486_input8s(uint16_t port, uint8_t *str, size_t len)
+	{
+		__asm__ __volatile__ (
+			"rep insb"
+			: "+D"(str), "+c"(len)
+			: "d"(port)
+			: "memory"
+		);
+	}
+
+	/**
+	 * @brief Writes a 8-bit string to a legacy I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  8-bit string to write.
+	 * @param len  Length of the string.
+	 *
+	 * @note Each byte is followed by an I/O delay, for devices that
+	 * cannot keep up with back-to-back accesses.
+	 */
+	static inline void i486_output8s_paced(uint16_t port, const uint8_t *str, size_t len)
 	{
 		for (size_t i = 0; i < len; i++)
 		{
@@ -73,6 +170,25 @@
 		}
 	}
 
+	/**
+	 * @brief Reads a 8-bit string from a legacy I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  Target 8-bit string.
+	 * @param len  Length of the string.
+	 *
+	 * @note Each byte is followed by an I/O delay, for devices that
+	 * cannot keep up with back-to-back accesses.
+	 */
+	static inline void i486_input8s_paced(uint16_t port, uint8_t *str, size_t len)
+	{
+		for (size_t i = 0; i < len; i++)
+		{
+			str[i] = i486_input8(port);
+			i486_iowait();
+		}
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -87,11 +203,23 @@
 	 * @name Provided Functions
 	 */
 	/**@{*/
-	#define __output8_fn  /**< i486_output8()  */
-	#define __output8s_fn /**< i486_output8s() */
-	#define __iowait_fn   /**< iowait()        */
+	#define __input8_fn    /**< i486_input8()    */
+	#define __output8_fn   /**< i486_output8()   */
+	#define __input8s_fn   /**< i486_input8s()   */
+	#define __output8s_fn  /**< i486_output8s()  */
+	#define __output16s_fn /**< i486_output16s() */
+	#define __output32s_fn /**< i486_output32s() */
+	#define __iowait_fn    /**< iowait()         */
 	/**@}*/
 
+	/**
+	 * @see i486_input8().
+	 */
+	static inline uint8_t input8(uint16_t port)
+	{
+		return (i486_input8(port));
+	}
+
 	/**
 	 * @see i486_output8().
 	 */
@@ -108,6 +236,30 @@
 		i486_output8s(port, str, len);
 	}
 
+	/**
+	 * @see i486_input8s().
+	 */
+	static inline void input8s(uint16_t port, uint8_t *str, size_t len)
+	{
+		i486_input8s(port, str, len);
+	}
+
+	/**
+	 * @see i486_output16s().
+	 */
+	static inline void output16s(uint16_t port, const uint16_t *str, size_t len)
+	{
+		i486_output16s(port, str, len);
+	}
+
+	/**
+	 * @see i486_output32s().
+	 */
+	static inline void output32s(uint16_t port, const uint32_t *str, size_t len)
+	{
+		i486_output32s(port, str, len);
+	}
+
 	/**
 	 * @see i486_iowait().
 	 */
@@ -35,6 +35,8 @@
 
 #ifndef _ASM_FILE_
 
+	#include <arch/core/i486/atomic.h>
+	#include <arch/core/i486/cache.h>
 	#include <nanvix/const.h>
 	#include <stdint.h>
 
@@ -115,6 +117,202 @@
 		*lock = I486_SPINLOCK_UNLOCKED;
 	}
 
+#ifndef _ASM_FILE_
+
+	/**
+	 * @name Reader-Writer Spinlock State
+	 */
+	/**@{*/
+	#define I486_RWLOCK_WRITER  0x80000000 /**< Writer holds the lock. */
+	#define I486_RWLOCK_WAITING 0x40000000 /**< Writer is waiting.     */
+	#define I486_RWLOCK_READERS 0x3fffffff /**< Number of readers.     */
+	/**@}*/
+
+	/**
+	 * @brief Reader-writer spinlock.
+	 *
+	 * Readers hold the lock in parallel. A waiting writer keeps new
+	 * readers out, so that writers do not starve.
+	 */
+	typedef struct
+	{
+		volatile uint32_t state; /**< Lock state. */
+	} i486_rwlock_t;
+
+	/**
+	 * @brief Initializes a i486_rwlock_t.
+	 *
+	 * @param lock Target i486_rwlock_t.
+	 */
+	static inline void i486_rwlock_init(i486_rwlock_t *lock)
+	{
+		lock->state = 0;
+	}
+
+	/**
+	 * @brief Locks a i486_rwlock_t for reading.
+	 *
+	 * @param lock Target i486_rwlock_t.
+	 */
+	static inline void i486_rwlock_read_lock(i486_rwlock_t *lock)
+	{
+		uint32_t state;
+
+		do
+		{
+			state = lock->state;
+
+			/* Writer holds or waits for the lock. */
+			if (state & (I486_RWLOCK_WRITER | I486_RWLOCK_WAITING))
+				continue;
+
+			if (i486_atomic_cas(&lock->state, state, state + 1) == state)
+				break;
+		} while (TRUE);
+
+		__sync_synchronize();
+	}
+
+	/**
+	 * @brief Unlocks a i486_rwlock_t locked for reading.
+	 *
+	 * @param lock Target i486_rwlock_t.
+	 */
+	static inline void i486_rwlock_read_unlock(i486_rwlock_t *lock)
+	{
+		__sync_synchronize();
+		i486_atomic_fetch_add(&lock->state, (uint32_t) -1);
+	}
+
+	/**
+	 * @brief Locks a i486_rwlock_t for writing.
+	 *
+	 * @param lock Target i486_rwlock_t.
+	 */
+	static inline void i486_rwlock_write_lock(i486_rwlock_t *lock)
+	{
+		uint32_t state;
+
+		do
+		{
+			state = lock->state;
+
+			/* Another writer holds the lock. */
+			if (state & I486_RWLOCK_WRITER)
+				continue;
+
+			/* Readers hold the lock, so keep new ones out. */
+			if (state & I486_RWLOCK_READERS)
+			{
+				if (!(state & I486_RWLOCK_WAITING))
+					i486_atomic_cas(&lock->state, state, state | I486_RWLOCK_WAITING);
+				continue;
+			}
+
+			if (i486_atomic_cas(&lock->state, state, I486_RWLOCK_WRITER) == state)
+				break;
+		} while (TRUE);
+
+		__sync_synchronize();
+	}
+
+	/**
+	 * @brief Unlocks a i486_rwlock_t locked for writing.
+	 *
+	 * @param lock Target i486_rwlock_t.
+	 */
+	static inline void i486_rwlock_write_unlock(i486_rwlock_t *lock)
+	{
+		__sync_synchronize();
+		i486_atomic_fetch_add(&lock->state, (uint32_t) -I486_RWLOCK_WRITER);
+	}
+
+	/**
+	 * @brief Sequence lock.
+	 *
+	 * Writers are serialized by a spinlock. Readers never block
+	 * writers: they retry if a write took place meanwhile.
+	 */
+	typedef struct
+	{
+		volatile uint32_t seq; /**< Sequence number (odd while writing). */
+		i486_spinlock_t lock;   /**< Writers lock.                        */
+	} i486_seqlock_t;
+
+	/**
+	 * @brief Initializes a i486_seqlock_t.
+	 *
+	 * @param lock Target i486_seqlock_t.
+	 */
+	static inline void i486_seqlock_init(i486_seqlock_t *lock)
+	{
+		lock->seq = 0;
+		i486_spinlock_init(&lock->lock);
+	}
+
+	/**
+	 * @brief Locks a i486_seqlock_t for writing.
+	 *
+	 * @param lock Target i486_seqlock_t.
+	 */
+	static inline void i486_seqlock_write_lock(i486_seqlock_t *lock)
+	{
+		i486_spinlock_lock(&lock->lock);
+		lock->seq = lock->seq + 1;
+		__sync_synchronize();
+	}
+
+	/**
+	 * @brief Unlocks a i486_seqlock_t locked for writing.
+	 *
+	 * @param lock Target i486_seqlock_t.
+	 */
+	static inline void i486_seqlock_write_unlock(i486_seqlock_t *lock)
+	{
+		__sync_synchronize();
+		lock->seq = lock->seq + 1;
+		i486_spinlock_unlock(&lock->lock);
+	}
+
+	/**
+	 * @brief Begins a read-side critical section of a i486_seqlock_t.
+	 *
+	 * @param lock Target i486_seqlock_t.
+	 *
+	 * @returns A sequence number to be handed to
+	 * i486_seqlock_read_retry().
+	 */
+	static inline uint32_t i486_seqlock_read_begin(i486_seqlock_t *lock)
+	{
+		uint32_t seq;
+
+		/* Wait for ongoing write. */
+		while ((seq = lock->seq) & 1)
+			/* noop */;
+
+		__sync_synchronize();
+
+		return (seq);
+	}
+
+	/**
+	 * @brief Ends a read-side critical section of a i486_seqlock_t.
+	 *
+	 * @param lock Target i486_seqlock_t.
+	 * @param seq  Sequence number returned by i486_seqlock_read_begin().
+	 *
+	 * @returns Non-zero if a write took place meanwhile, and thus the
+	 * read-side critical section should be retried, and zero otherwise.
+	 */
+	static inline int i486_seqlock_read_retry(i486_seqlock_t *lock, uint32_t seq)
+	{
+		__sync_synchronize();
+
+		return (lock->seq != seq);
+	}
+
+#endif /* _ASM_FILE_ */
+
 /**@}*/
 
 /*============================================================================*
@@ -134,6 +332,18 @@
 	#define __spinlock_lock_fn    /**< spinlock_lock()    */
 	#define __spinlock_trylock_fn /**< spinlock_trylock() */
 	#define __spinlock_unlock_fn  /**< spinlock_unlock()  */
+	#define __rwlock_t                /**< @see rwlock_t            */
+	#define __rwlock_init_fn          /**< rwlock_init()            */
+	#define __rwlock_read_lock_fn     /**< rwlock_read_lock()       */
+	#define __rwlock_read_unlock_fn   /**< rwlock_read_unlock()     */
+	#define __rwlock_write_lock_fn    /**< rwlock_write_lock()      */
+	#define __rwlock_write_unlock_fn  /**< rwlock_write_unlock()    */
+	#define __seqlock_t               /**< @see seqlock_t           */
+	#define __seqlock_init_fn         /**< seqlock_init()           */
+	#define __seqlock_write_lock_fn   /**< seqlock_write_lock()     */
+	#define __seqlock_write_unlock_fn /**< seqlock_write_unlock()   */
+	#define __seqlock_read_begin_fn   /**< seqlock_read_begin()     */
+	#define __seqlock_read_retry_fn   /**< seqlock_read_retry()     */
 	/**@}*/
 
 	/**
@@ -144,6 +354,11 @@
 	#define SPINLOCK_LOCKED   I486_SPINLOCK_LOCKED   /**< @see I486_SPINLOCK_LOCKED   */
 	/**@}*/
 
+	/**
+	 * @brief Asserts if @p ret, returned by spinlock_trylock(), means success.
+	 */
+	#define SPINLOCK_TRYLOCK_OK(ret) ((ret) == 0)
+
 #ifndef _ASM_FILE_
 
 	/**
@@ -183,6 +398,96 @@
 		i486_spinlock_unlock(lock);
 	}
 
+	/**
+	 * @see i486_rwlock_t
+	 */
+	typedef i486_rwlock_t rwlock_t;
+
+	/**
+	 * @see i486_seqlock_t
+	 */
+	typedef i486_seqlock_t seqlock_t;
+
+	/**
+	 * @see i486_rwlock_init().
+	 */
+	static inline void rwlock_init(rwlock_t *lock)
+	{
+		i486_rwlock_init(lock);
+	}
+
+	/**
+	 * @see i486_rwlock_read_lock().
+	 */
+	static inline void rwlock_read_lock(rwlock_t *lock)
+	{
+		i486_rwlock_read_lock(lock);
+	}
+
+	/**
+	 * @see i486_rwlock_read_unlock().
+	 */
+	static inline void rwlock_read_unlock(rwlock_t *lock)
+	{
+		i486_rwlock_read_unlock(lock);
+	}
+
+	/**
+	 * @see i486_rwlock_write_lock().
+	 */
+	static inline void rwlock_write_lock(rwlock_t *lock)
+	{
+		i486_rwlock_write_lock(lock);
+	}
+
+	/**
+	 * @see i486_rwlock_write_unlock().
+	 */
+	static inline void rwlock_write_unlock(rwlock_t *lock)
+	{
+		i486_rwlock_write_unlock(lock);
+	}
+
+	/**
+	 * @see i486_seqlock_init().
+	 */
+	static inline void seqlock_init(seqlock_t *lock)
+	{
+		i486_seqlock_init(lock);
+	}
+
+	/**
+	 * @see i486_seqlock_write_lock().
+	 */
+	static inline void seqlock_write_lock(seqlock_t *lock)
+	{
+		i486_seqlock_write_lock(lock);
+	}
+
+	/**
+	 * @see i486_seqlock_write_unlock().
+	 */
+	static inline void seqlock_write_unlock(seqlock_t *lock)
+	{
+		i486_seqlock_write_unlock(lock);
+	}
+
+	/**
+	 * @see i486_seqlock_read_begin().
+	 */
+	static inline uint32_t seqlock_read_begin(seqlock_t *lock)
+	{
+		return (i486_seqlock_read_begin(lock));
+	}
+
+	/**
+	 * @see i486_seqlock_read_retry().
+	 */
+	static inline int seqlock_read_retry(seqlock_t *lock, uint32_t seq)
+	{
+		return (i486_seqlock_read_retry(lock, seq));
+	}
+
 #endif /* _ASM_FILE_ */
 
 /**@endcond*/
@@ -33,6 +33,8 @@
  */
 /**@{*/
 
+	#include <arch/core/i486/mmu.h>
+
 	/**
 	 * @brief Hardware-managed TLB.
 	 */
@@ -42,9 +44,19 @@
 	 * @name Provided Interface
 	 */
 	/**@{*/
-	#define __tlb_flush_fn /**< tlb_flush() */
+	#define __tlb_flush_fn       /**< tlb_flush()       */
+	#define __tlb_write_range_fn /**< tlb_write_range() */
+	#define __tlb_inval_range_fn /**< tlb_inval_range() */
 	/**@}*/
 
+	/**
+	 * @brief Maximum number of pages invalidated one by one.
+	 *
+	 * Larger ranges are cheaper to drop by reloading CR3 than by
+	 * issuing one invlpg per page.
+	 */
+	#define I486_TLB_INVLPG_MAX 32
+
 	/**
 	 * @brief Flushes changes in the TLB.
 	 *
@@ -68,6 +80,48 @@
 		return (0);
 	}
 
+	/**
+	 * @brief Invalidates a page in the TLB.
+	 *
+	 * @param vaddr Target virtual address.
+	 *
+	 * The i486_tlb_inval_page() function drops the translation of
+	 * the page that contains @p vaddr from the TLB of the underlying
+	 * i486 core.
+	 */
+	static inline void i486_tlb_inval_page(vaddr_t vaddr)
+	{
+		__asm__ __volatile__ (
+			"invlpg (%0)"
+			:
+			: "r" (vaddr)
+			: "memory"
+		);
+	}
+
+	/**
+	 * @brief Invalidates a range of pages in the TLB.
+	 *
+	 * @param vaddr  Start virtual address.
+	 * @param npages Number of pages.
+	 *
+	 * The i486_tlb_inval_range() function drops the translations of
+	 * @p npages pages starting at @p vaddr. Small ranges are dropped
+	 * page by page, large ones with a full TLB flush.
+	 *
+	 * @returns This function always returns zero.
+	 */
+	static inline int i486_tlb_inval_range(vaddr_t vaddr, size_t npages)
+	{
+		if (npages > I486_TLB_INVLPG_MAX)
+			return (i486_tlb_flush());
+
+		for (size_t i = 0; i < npages; i++)
+			i486_tlb_inval_page(vaddr + i*I486_PAGE_SIZE);
+
+		return (0);
+	}
+
 	/**
 	 * @see i486_tlb_flush().
 	 */
@@ -76,6 +130,30 @@
 		return (i486_tlb_flush());
 	}
 
+	/**
+	 * @see i486_tlb_inval_range().
+	 *
+	 * @note The TLB is refilled from the page tables, thus writing a
+	 * range amounts to dropping stale translations.
+	 */
+	static inline int tlb_write_range(int tlb_type, vaddr_t vaddr, paddr_t paddr, size_t npages)
+	{
+		((void) tlb_type);
+		((void) paddr);
+
+		return (i486_tlb_inval_range(vaddr, npages));
+	}
+
+	/**
+	 * @see i486_tlb_inval_range().
+	 */
+	static inline int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t npages)
+	{
+		((void) tlb_type);
+
+		return (i486_tlb_inval_range(vaddr, npages));
+	}
+
 /**@}*/
 	
 #endif /* ARCH_I486_TLB_H_ */
@@ -34,6 +34,8 @@
 		#error "k1b core not required"
 	#endif
 
+	#include <arch/core/k1b/atomic.h>
+	#include <arch/core/k1b/bitops.h>
 	#include <arch/core/k1b/cache.h>
 	#include <arch/core/k1b/clock.h>
 	#include <arch/core/k1b/core.h>
@@ -0,0 +1,324 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CORE_K1B_ATOMIC_H_
+#define ARCH_CORE_K1B_ATOMIC_H_
+
+/**
+ * @addtogroup k1b-core-atomic Atomic
+ * @ingroup k1b-core
+ *
+ * @brief k1b Atomic Operations
+ *
+ * The data cache of the k1b core is not coherent, so atomic
+ * operations access memory with uncached loads and stores.
+ * Read-modify-write operations are serialized by a small set of
+ * hardware-assisted (ldc) guard locks, selected by address.
+ */
+/**@{*/
+
+	/* External dependencies. */
+	#include <HAL/hal/hal_ext.h>
+	#include <arch/core/k1b/spinlock.h>
+	#include <nanvix/const.h>
+	#include <stdint.h>
+
+	/**
+	 * @brief Number of guard locks (power of two).
+	 */
+	#define K1B_ATOMIC_LOCKS_NUM 8
+
+	/**
+	 * @brief Guard locks.
+	 */
+	EXTERN k1b_spinlock_t k1b_atomic_locks[K1B_ATOMIC_LOCKS_NUM];
+
+	/**
+	 * @brief Acquires the guard lock of a word.
+	 *
+	 * @param ptr Target word.
+	 *
+	 * @returns The guard lock of the word pointed to by @p ptr.
+	 */
+	static inline k1b_spinlock_t *k1b_atomic_guard_lock(volatile uint32_t *ptr)
+	{
+		k1b_spinlock_t *guard;
+
+		guard = &k1b_atomic_locks[
+			(((uint32_t) ptr) >> 2) & (K1B_ATOMIC_LOCKS_NUM - 1)
+		];
+
+		while (!k1b_spinlock_trylock(guard))
+			/* noop */;
+
+		return (guard);
+	}
+
+	/**
+	 * @brief Releases a guard lock.
+	 *
+	 * @param guard Target guard lock.
+	 */
+	static inline void k1b_atomic_guard_unlock(k1b_spinlock_t *guard)
+	{
+		__builtin_k1_fence();
+		__builtin_k1_sdu(guard, K1B_SPINLOCK_UNLOCKED);
+	}
+
+	/**
+	 * @brief Atomically loads a word.
+	 *
+	 * @param ptr Target word.
+	 *
+	 * @returns The value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t k1b_atomic_load(const volatile uint32_t *ptr)
+	{
+		return (__builtin_k1_lwu((void *) ptr));
+	}
+
+	/**
+	 * @brief Atomically stores a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 */
+	static inline void k1b_atomic_store(volatile uint32_t *ptr, uint32_t val)
+	{
+		__builtin_k1_swu((void *) ptr, val);
+		__builtin_k1_fence();
+	}
+
+	/**
+	 * @brief Atomically exchanges a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t k1b_atomic_xchg(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		k1b_spinlock_t *guard;
+
+		guard = k1b_atomic_guard_lock(ptr);
+			old = k1b_atomic_load(ptr);
+			k1b_atomic_store(ptr, val);
+		k1b_atomic_guard_unlock(guard);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically compares and swaps a word.
+	 *
+	 * @param ptr    Target word.
+	 * @param oldval Expected value.
+	 * @param newval Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr. The
+	 * swap took place if and only if it equals @p oldval.
+	 */
+	static inline uint32_t k1b_atomic_cas(volatile uint32_t *ptr, uint32_t oldval, uint32_t newval)
+	{
+		uint32_t old;
+		k1b_spinlock_t *guard;
+
+		guard = k1b_atomic_guard_lock(ptr);
+			old = k1b_atomic_load(ptr);
+			if (old == oldval)
+				k1b_atomic_store(ptr, newval);
+		k1b_atomic_guard_unlock(guard);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically adds a value to a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to add.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t k1b_atomic_fetch_add(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		k1b_spinlock_t *guard;
+
+		guard = k1b_atomic_guard_lock(ptr);
+			old = k1b_atomic_load(ptr);
+			k1b_atomic_store(ptr, old + val);
+		k1b_atomic_guard_unlock(guard);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically subtracts a value from a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to subtract.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t k1b_atomic_fetch_sub(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (k1b_atomic_fetch_add(ptr, -val));
+	}
+
+	/**
+	 * @brief Atomically ORs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to OR.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t k1b_atomic_fetch_or(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		k1b_spinlock_t *guard;
+
+		guard = k1b_atomic_guard_lock(ptr);
+			old = k1b_atomic_load(ptr);
+			k1b_atomic_store(ptr, old | val);
+		k1b_atomic_guard_unlock(guard);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically ANDs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to AND.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t k1b_atomic_fetch_and(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		k1b_spinlock_t *guard;
+
+		guard = k1b_atomic_guard_lock(ptr);
+			old = k1b_atomic_load(ptr);
+			k1b_atomic_store(ptr, old & val);
+		k1b_atomic_guard_unlock(guard);
+
+		return (old);
+	}
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond k1b
+ */
+
+	/**
+	 * @name Provided Interface
+	 */
+	/**@{*/
+	#define __atomic_load_fn      /**< atomic_load()      */
+	#define __atomic_store_fn     /**< atomic_store()     */
+	#define __atomic_xchg_fn      /**< atomic_xchg()      */
+	#define __atomic_cas_fn       /**< atomic_cas()       */
+	#define __atomic_fetch_add_fn /**< atomic_fetch_add() */
+	#define __atomic_fetch_sub_fn /**< atomic_fetch_sub() */
+	#define __atomic_fetch_or_fn  /**< atomic_fetch_or()  */
+	#define __atomic_fetch_and_fn /**< atomic_fetch_and() */
+	/**@}*/
+
+	/**
+	 * @see k1b_atomic_load().
+	 */
+	static inline uint32_t atomic_load(const volatile uint32_t *ptr)
+	{
+		return (k1b_atomic_load(ptr));
+	}
+
+	/**
+	 * @see k1b_atomic_store().
+	 */
+	static inline void atomic_store(volatile uint32_t *ptr, uint32_t val)
+	{
+		k1b_atomic_store(ptr, val);
+	}
+
+	/**
+	 * @see k1b_atomic_xchg().
+	 */
+	static inline uint32_t atomic_xchg(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (k1b_atomic_xchg(ptr, val));
+	}
+
+	/**
+	 * @see k1b_atomic_cas().
+	 */
+	static inline uint32_t atomic_cas(volatile uint32_t *ptr, uint32_t oldval, uint32_t newval)
+	{
+		return (k1b_atomic_cas(ptr, oldval, newval));
+	}
+
+	/**
+	 * @see k1b_atomic_fetch_add().
+	 */
+	static inline uint32_t atomic_fetch_add(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (k1b_atomic_fetch_add(ptr, val));
+	}
+
+	/**
+	 * @see k1b_atomic_fetch_sub().
+	 */
+	static inline uint32_t atomic_fetch_sub(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (k1b_atomic_fetch_sub(ptr, val));
+	}
+
+	/**
+	 * @see k1b_atomic_fetch_or().
+	 */
+	static inline uint32_t atomic_fetch_or(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (k1b_atomic_fetch_or(ptr, val));
+	}
+
+	/**
+	 * @see k1b_atomic_fetch_and().
+	 */
+	static inline uint32_t atomic_fetch_and(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (k1b_atomic_fetch_and(ptr, val));
+	}
+
+/**@endcond*/
+
+#endif /* ARCH_CORE_K1B_ATOMIC_H_ */
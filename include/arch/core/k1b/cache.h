@@ -33,6 +33,9 @@
  */
 /**@{*/
 
+	#include <stddef.h>
+	#include <stdint.h>
+
 	/**
 	 * @brief Cache line size (in bytes).
 	 *
@@ -60,6 +63,80 @@
 		__builtin_k1_dinval();
 	}
 
+	/**
+	 * @brief Invalidates a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 */
+	static inline void k1b_dcache_inval_range(const void *addr, size_t len)
+	{
+		uintptr_t start;
+		uintptr_t end;
+
+		if (len == 0)
+			return;
+
+		start = ((uintptr_t) addr) & ~(K1B_CACHE_LINE_SIZE - 1);
+		end = ((uintptr_t) addr) + len;
+
+		for (uintptr_t line = start; line < end; line += K1B_CACHE_LINE_SIZE)
+			__builtin_k1_dinvall((void *) line);
+	}
+
+	/**
+	 * @brief Writes back a range of the data cache.
+	 *
+	 * The data cache is write-through, so only the write buffer has
+	 * to be drained, regardless of the target memory area.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 */
+	static inline void k1b_dcache_flush_range(const void *addr, size_t len)
+	{
+		((void) addr);
+		((void) len);
+
+		__builtin_k1_wpurge();
+		__builtin_k1_fence();
+	}
+
+	/**
+	 * @brief Writes back and invalidates a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 */
+	static inline void k1b_dcache_flush_inval_range(const void *addr, size_t len)
+	{
+		k1b_dcache_flush_range(addr, len);
+		k1b_dcache_inval_range(addr, len);
+	}
+
+	/**
+	 * @brief Read memory barrier.
+	 *
+	 * Drops stale lines from the data cache, so that subsequent loads
+	 * fetch data written back by other cores.
+	 */
+	static inline void k1b_rmb(void)
+	{
+		__builtin_k1_dinval();
+	}
+
+	/**
+	 * @brief Write memory barrier.
+	 *
+	 * The data cache is write-through, so draining the write buffer
+	 * makes previous stores visible to other cores.
+	 */
+	static inline void k1b_wmb(void)
+	{
+		__builtin_k1_wpurge();
+		__builtin_k1_fence();
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -74,7 +151,15 @@
 	 * @name Provided Interface
 	 */
 	/**@{*/
-	#define __dcache_invalidate_fn /**< dcache_invalidate() */
+	#define __dcache_invalidate_fn              /**< dcache_invalidate()              */
+	#define __dcache_invalidate_range_fn        /**< dcache_invalidate_range()        */
+	#define __dcache_flush_range_fn             /**< dcache_flush_range()             */
+	#define __dcache_flush_invalidate_range_fn  /**< dcache_flush_invalidate_range()  */
+	#define __hal_mb_fn                         /**< hal_mb()                         */
+	#define __hal_rmb_fn                        /**< hal_rmb()                        */
+	#define __hal_wmb_fn                        /**< hal_wmb()                        */
+	#define __hal_acquire_fn                    /**< hal_acquire()                    */
+	#define __hal_release_fn                    /**< hal_release()                    */
 	/**@}*/
 
 	/**
@@ -90,6 +175,71 @@
 		k1b_dcache_inval();
 	}
 
+	/**
+	 * @see k1b_dcache_inval_range().
+	 */
+	static inline void dcache_invalidate_range(const void *addr, size_t len)
+	{
+		k1b_dcache_inval_range(addr, len);
+	}
+
+	/**
+	 * @see k1b_dcache_flush_range().
+	 */
+	static inline void dcache_flush_range(const void *addr, size_t len)
+	{
+		k1b_dcache_flush_range(addr, len);
+	}
+
+	/**
+	 * @see k1b_dcache_flush_inval_range().
+	 */
+	static inline void dcache_flush_invalidate_range(const void *addr, size_t len)
+	{
+		k1b_dcache_flush_inval_range(addr, len);
+	}
+
+	/**
+	 * @see k1b_wmb() and k1b_rmb().
+	 */
+	static inline void hal_mb(void)
+	{
+		k1b_wmb();
+		k1b_rmb();
+	}
+
+	/**
+	 * @see k1b_rmb().
+	 */
+	static inline void hal_rmb(void)
+	{
+		k1b_rmb();
+	}
+
+	/**
+	 * @see k1b_wmb().
+	 */
+	static inline void hal_wmb(void)
+	{
+		k1b_wmb();
+	}
+
+	/**
+	 * @see k1b_rmb().
+	 */
+	static inline void hal_acquire(void)
+	{
+		k1b_rmb();
+	}
+
+	/**
+	 * @see k1b_wmb().
+	 */
+	static inline void hal_release(void)
+	{
+		k1b_wmb();
+	}
+
 /**@endcond*/
 
 #endif /* CORE_K1B_CACHE_H_ */
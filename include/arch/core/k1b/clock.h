@@ -32,7 +32,16 @@
  * @brief Programmable Timer Interface
  */
 /**@{*/
-	
+
+	#include <mOS_vcore_u.h>
+	#include <nanvix/const.h>
+	#include <stdint.h>
+
+	/**
+	 * @brief Frequency of the DSU timestamp counter (in Hz), 400Mhz.
+	 */
+	#define K1B_CLOCK_FREQUENCY 400000000
+
 	/**
 	 * @brief Initializes the clock driver in the k1b architecture.
 	 *
@@ -40,6 +49,26 @@
 	 */
 	extern void k1b_clock_init(unsigned freq);
 
+	/**
+	 * @brief Reads the cycle counter.
+	 *
+	 * @returns The value of the DSU timestamp counter.
+	 */
+	static inline uint64_t k1b_clock_read_cycles(void)
+	{
+		return (__k1_read_dsu_timestamp());
+	}
+
+	/**
+	 * @brief Gets the frequency of the cycle counter.
+	 *
+	 * @returns The frequency of the cycle counter (in Hz).
+	 */
+	static inline uint32_t k1b_clock_cycles_freq(void)
+	{
+		return (K1B_CLOCK_FREQUENCY);
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -54,7 +83,9 @@
 	 * @name Provided Interface
 	 */
 	/**@{*/
-	#define __clock_init_fn /**< clock_init() */
+	#define __clock_init_fn        /**< clock_init()        */
+	#define __clock_read_cycles_fn /**< clock_read_cycles() */
+	#define __clock_cycles_freq_fn /**< clock_cycles_freq() */
 	/**@}*/
 
 	/**
@@ -65,6 +96,22 @@
 		k1b_clock_init(freq);
 	}
 
+	/**
+	 * @see k1b_clock_read_cycles().
+	 */
+	static inline uint64_t clock_read_cycles(void)
+	{
+		return (k1b_clock_read_cycles());
+	}
+
+	/**
+	 * @see k1b_clock_cycles_freq().
+	 */
+	static inline uint32_t clock_cycles_freq(void)
+	{
+		return (k1b_clock_cycles_freq());
+	}
+
 /**@endcond*/
 
 #endif /* ARCH_CORE_K1B_CLOCK */
@@ -65,6 +65,30 @@
 		__k1_club_syscall2(port, (unsigned) str, len);
 	}
 
+	/**
+	 * @brief Writes a 16-bit string to an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  16-bit string to write.
+	 * @param len  Length of the string (in 16-bit words).
+	 */
+	static inline void k1b_output16s(uint16_t port, const uint16_t *str, size_t len)
+	{
+		k1b_output8s(port, (const uint8_t *) str, len*sizeof(uint16_t));
+	}
+
+	/**
+	 * @brief Writes a 32-bit string to an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  32-bit string to write.
+	 * @param len  Length of the string (in 32-bit words).
+	 */
+	static inline void k1b_output32s(uint16_t port, const uint32_t *str, size_t len)
+	{
+		k1b_output8s(port, (const uint8_t *) str, len*sizeof(uint32_t));
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -79,9 +103,11 @@
 	 * @name Provided Functions
 	 */
 	/**@{*/
-	#define __output8_fn  /**< k1b_output8()  */
-	#define __output8s_fn /**< k1b_output8s() */
-	#define __iowait_fn   /**< iowait()       */
+	#define __output8_fn   /**< k1b_output8()   */
+	#define __output8s_fn  /**< k1b_output8s()  */
+	#define __output16s_fn /**< k1b_output16s() */
+	#define __output32s_fn /**< k1b_output32s() */
+	#define __iowait_fn    /**< iowait()        */
 	/**@}*/
 
 	/**
@@ -100,6 +126,22 @@
 		k1b_output8s(port, str, len);
 	}
 
+	/**
+	 * @see k1b_output16s().
+	 */
+	static inline void output16s(uint16_t port, const uint16_t *str, size_t len)
+	{
+		k1b_output16s(port, str, len);
+	}
+
+	/**
+	 * @see k1b_output32s().
+	 */
+	static inline void output32s(uint16_t port, const uint32_t *str, size_t len)
+	{
+		k1b_output32s(port, str, len);
+	}
+
 	/**
 	 * @see k1b_iowait().
 	 */
@@ -99,6 +99,196 @@
 		__builtin_k1_sdu(lock, K1B_SPINLOCK_UNLOCKED);
 	}
 
+	/**
+	 * @brief Reader-writer spinlock.
+	 *
+	 * Readers hold the lock in parallel. A waiting writer keeps new
+	 * readers out, so that writers do not starve. The state is guarded
+	 * by a k1b_spinlock_t, since the k1b core lacks atomic
+	 * read-modify-write operations on cached memory.
+	 */
+	typedef struct
+	{
+		k1b_spinlock_t guard; /**< Guards the lock state. */
+		uint32_t readers;     /**< Number of readers.     */
+		uint32_t writer;      /**< Writer holds the lock? */
+		uint32_t waiting;     /**< Writers waiting.       */
+	} k1b_rwlock_t;
+
+	/**
+	 * @brief Initializes a k1b_rwlock_t.
+	 *
+	 * @param lock Target k1b_rwlock_t.
+	 */
+	static inline void k1b_rwlock_init(k1b_rwlock_t *lock)
+	{
+		lock->readers = 0;
+		lock->writer = 0;
+		lock->waiting = 0;
+		k1b_spinlock_init(&lock->guard);
+	}
+
+	/**
+	 * @brief Locks a k1b_rwlock_t for reading.
+	 *
+	 * @param lock Target k1b_rwlock_t.
+	 */
+	static inline void k1b_rwlock_read_lock(k1b_rwlock_t *lock)
+	{
+		do
+		{
+			k1b_spinlock_lock(&lock->guard);
+
+				if (!lock->writer && !lock->waiting)
+				{
+					lock->readers++;
+					k1b_spinlock_unlock(&lock->guard);
+					break;
+				}
+
+			k1b_spinlock_unlock(&lock->guard);
+		} while (1);
+	}
+
+	/**
+	 * @brief Unlocks a k1b_rwlock_t locked for reading.
+	 *
+	 * @param lock Target k1b_rwlock_t.
+	 */
+	static inline void k1b_rwlock_read_unlock(k1b_rwlock_t *lock)
+	{
+		k1b_spinlock_lock(&lock->guard);
+			lock->readers--;
+		k1b_spinlock_unlock(&lock->guard);
+	}
+
+	/**
+	 * @brief Locks a k1b_rwlock_t for writing.
+	 *
+	 * @param lock Target k1b_rwlock_t.
+	 */
+	static inline void k1b_rwlock_write_lock(k1b_rwlock_t *lock)
+	{
+		k1b_spinlock_lock(&lock->guard);
+			lock->waiting++;
+		k1b_spinlock_unlock(&lock->guard);
+
+		do
+		{
+			k1b_spinlock_lock(&lock->guard);
+
+				if (!lock->writer && (lock->readers == 0))
+				{
+					lock->writer = 1;
+					lock->waiting--;
+					k1b_spinlock_unlock(&lock->guard);
+					break;
+				}
+
+			k1b_spinlock_unlock(&lock->guard);
+		} while (1);
+	}
+
+	/**
+	 * @brief Unlocks a k1b_rwlock_t locked for writing.
+	 *
+	 * @param lock Target k1b_rwlock_t.
+	 */
+	static inline void k1b_rwlock_write_unlock(k1b_rwlock_t *lock)
+	{
+		k1b_spinlock_lock(&lock->guard);
+			lock->writer = 0;
+		k1b_spinlock_unlock(&lock->guard);
+	}
+
+	/**
+	 * @brief Sequence lock.
+	 *
+	 * Writers are serialized by a spinlock. Readers never block
+	 * writers: they retry if a write took place meanwhile.
+	 *
+	 * @note Readers invalidate the data cache, so that they see
+	 * updates from other cores.
+	 */
+	typedef struct
+	{
+		volatile uint32_t seq; /**< Sequence number (odd while writing). */
+		k1b_spinlock_t lock;   /**< Writers lock.                        */
+	} k1b_seqlock_t;
+
+	/**
+	 * @brief Initializes a k1b_seqlock_t.
+	 *
+	 * @param lock Target k1b_seqlock_t.
+	 */
+	static inline void k1b_seqlock_init(k1b_seqlock_t *lock)
+	{
+		lock->seq = 0;
+		k1b_spinlock_init(&lock->lock);
+	}
+
+	/**
+	 * @brief Locks a k1b_seqlock_t for writing.
+	 *
+	 * @param lock Target k1b_seqlock_t.
+	 */
+	static inline void k1b_seqlock_write_lock(k1b_seqlock_t *lock)
+	{
+		k1b_spinlock_lock(&lock->lock);
+		lock->seq = lock->seq + 1;
+		k1b_dcache_inval();
+	}
+
+	/**
+	 * @brief Unlocks a k1b_seqlock_t locked for writing.
+	 *
+	 * @param lock Target k1b_seqlock_t.
+	 */
+	static inline void k1b_seqlock_write_unlock(k1b_seqlock_t *lock)
+	{
+		k1b_dcache_inval();
+		lock->seq = lock->seq + 1;
+		k1b_spinlock_unlock(&lock->lock);
+	}
+
+	/**
+	 * @brief Begins a read-side critical section of a k1b_seqlock_t.
+	 *
+	 * @param lock Target k1b_seqlock_t.
+	 *
+	 * @returns A sequence number to be handed to
+	 * k1b_seqlock_read_retry().
+	 */
+	static inline uint32_t k1b_seqlock_read_begin(k1b_seqlock_t *lock)
+	{
+		uint32_t seq;
+
+		/* Wait for ongoing write. */
+		do
+		{
+			k1b_dcache_inval();
+			seq = lock->seq;
+		} while (seq & 1);
+
+		return (seq);
+	}
+
+	/**
+	 * @brief Ends a read-side critical section of a k1b_seqlock_t.
+	 *
+	 * @param lock Target k1b_seqlock_t.
+	 * @param seq  Sequence number returned by k1b_seqlock_read_begin().
+	 *
+	 * @returns Non-zero if a write took place meanwhile, and thus the
+	 * read-side critical section should be retried, and zero otherwise.
+	 */
+	static inline int k1b_seqlock_read_retry(k1b_seqlock_t *lock, uint32_t seq)
+	{
+		k1b_dcache_inval();
+
+		return (lock->seq != seq);
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -118,6 +308,28 @@
 	#define __spinlock_lock_fn    /**< spinlock_lock()    */
 	#define __spinlock_trylock_fn /**< spinlock_trylock() */
 	#define __spinlock_unlock_fn  /**< spinlock_unlock()  */
+	#define __ticketlock_t          /**< @see ticketlock_t    */
+	#define __ticketlock_init_fn    /**< ticketlock_init()    */
+	#define __ticketlock_lock_fn    /**< ticketlock_lock()    */
+	#define __ticketlock_trylock_fn /**< ticketlock_trylock() */
+	#define __ticketlock_unlock_fn  /**< ticketlock_unlock()  */
+	#define __qspinlock_t           /**< @see qspinlock_t     */
+	#define __qspinlock_init_fn     /**< qspinlock_init()     */
+	#define __qspinlock_lock_fn     /**< qspinlock_lock()     */
+	#define __qspinlock_trylock_fn  /**< qspinlock_trylock()  */
+	#define __qspinlock_unlock_fn   /**< qspinlock_unlock()   */
+	#define __rwlock_t                /**< @see rwlock_t            */
+	#define __rwlock_init_fn          /**< rwlock_init()            */
+	#define __rwlock_read_lock_fn     /**< rwlock_read_lock()       */
+	#define __rwlock_read_unlock_fn   /**< rwlock_read_unlock()     */
+	#define __rwlock_write_lock_fn    /**< rwlock_write_lock()      */
+	#define __rwlock_write_unlock_fn  /**< rwlock_write_unlock()    */
+	#define __seqlock_t               /**< @see seqlock_t           */
+	#define __seqlock_init_fn         /**< seqlock_init()           */
+	#define __seqlock_write_lock_fn   /**< seqlock_write_lock()     */
+	#define __seqlock_write_unlock_fn /**< seqlock_write_unlock()   */
+	#define __seqlock_read_begin_fn   /**< seqlock_read_begin()     */
+	#define __seqlock_read_retry_fn   /**< seqlock_read_retry()     */
 	/**@}*/
 
 	/**
@@ -133,6 +345,11 @@
 	#define SPINLOCK_LOCKED   K1B_SPINLOCK_LOCKED   /**< @see K1B_SPINLOCK_LOCKED   */
 	/**@}*/
 
+	/**
+	 * @brief Asserts if @p ret, returned by spinlock_trylock(), means success.
+	 */
+	#define SPINLOCK_TRYLOCK_OK(ret) ((ret) != 0)
+
 	/**
 	 * @see k1b_spinlock_init().
 	 */
@@ -176,6 +393,176 @@
 		k1b_spinlock_unlock(lock);
 	}
 
+	/**
+	 * @brief Ticket lock.
+	 *
+	 * @note Caches of the k1b core are not coherent, so waiters always
+	 * poll the lock in memory. Thus, ticket and queue spinlocks fall
+	 * back to the hardware-assisted k1b_spinlock_t.
+	 */
+	typedef k1b_spinlock_t ticketlock_t;
+
+	/**
+	 * @brief Queue spinlock.
+	 *
+	 * @see ticketlock_t
+	 */
+	typedef k1b_spinlock_t qspinlock_t;
+
+	/**
+	 * @see spinlock_init().
+	 */
+	static inline void ticketlock_init(ticketlock_t *lock)
+	{
+		spinlock_init(lock);
+	}
+
+	/**
+	 * @see spinlock_trylock().
+	 */
+	static inline int ticketlock_trylock(ticketlock_t *lock)
+	{
+		return (spinlock_trylock(lock));
+	}
+
+	/**
+	 * @see spinlock_lock().
+	 */
+	static inline void ticketlock_lock(ticketlock_t *lock)
+	{
+		spinlock_lock(lock);
+	}
+
+	/**
+	 * @see spinlock_unlock().
+	 */
+	static inline void ticketlock_unlock(ticketlock_t *lock)
+	{
+		spinlock_unlock(lock);
+	}
+
+	/**
+	 * @see spinlock_init().
+	 */
+	static inline void qspinlock_init(qspinlock_t *lock)
+	{
+		spinlock_init(lock);
+	}
+
+	/**
+	 * @see spinlock_trylock().
+	 */
+	static inline int qspinlock_trylock(qspinlock_t *lock)
+	{
+		return (spinlock_trylock(lock));
+	}
+
+	/**
+	 * @see spinlock_lock().
+	 */
+	static inline void qspinlock_lock(qspinlock_t *lock)
+	{
+		spinlock_lock(lock);
+	}
+
+	/**
+	 * @see spinlock_unlock().
+	 */
+	static inline void qspinlock_unlock(qspinlock_t *lock)
+	{
+		spinlock_unlock(lock);
+	}
+
+	/**
+	 * @see k1b_rwlock_t
+	 */
+	typedef k1b_rwlock_t rwlock_t;
+
+	/**
+	 * @see k1b_seqlock_t
+	 */
+	typedef k1b_seqlock_t seqlock_t;
+
+	/**
+	 * @see k1b_rwlock_init().
+	 */
+	static inline void rwlock_init(rwlock_t *lock)
+	{
+		k1b_rwlock_init(lock);
+	}
+
+	/**
+	 * @see k1b_rwlock_read_lock().
+	 */
+	static inline void rwlock_read_lock(rwlock_t *lock)
+	{
+		k1b_rwlock_read_lock(lock);
+	}
+
+	/**
+	 * @see k1b_rwlock_read_unlock().
+	 */
+	static inline void rwlock_read_unlock(rwlock_t *lock)
+	{
+		k1b_rwlock_read_unlock(lock);
+	}
+
+	/**
+	 * @see k1b_rwlock_write_lock().
+	 */
+	static inline void rwlock_write_lock(rwlock_t *lock)
+	{
+		k1b_rwlock_write_lock(lock);
+	}
+
+	/**
+	 * @see k1b_rwlock_write_unlock().
+	 */
+	static inline void rwlock_write_unlock(rwlock_t *lock)
+	{
+		k1b_rwlock_write_unlock(lock);
+	}
+
+	/**
+	 * @see k1b_seqlock_init().
+	 */
+	static inline void seqlock_init(seqlock_t *lock)
+	{
+		k1b_seqlock_init(lock);
+	}
+
+	/**
+	 * @see k1b_seqlock_write_lock().
+	 */
+	static inline void seqlock_write_lock(seqlock_t *lock)
+	{
+		k1b_seqlock_write_lock(lock);
+	}
+
+	/**
+	 * @see k1b_seqlock_write_unlock().
+	 */
+	static inline void seqlock_write_unlock(seqlock_t *lock)
+	{
+		k1b_seqlock_write_unlock(lock);
+	}
+
+	/**
+	 * @see k1b_seqlock_read_begin().
+	 */
+	static inline uint32_t seqlock_read_begin(seqlock_t *lock)
+	{
+		return (k1b_seqlock_read_begin(lock));
+	}
+
+	/**
+	 * @see k1b_seqlock_read_retry().
+	 */
+	static inline int seqlock_read_retry(seqlock_t *lock, uint32_t seq)
+	{
+		return (k1b_seqlock_read_retry(lock, seq));
+	}
+
 /**@endcond*/
 
 #endif /* ARCH_CORE_K1B_SPINLOCK_H_ */
@@ -61,6 +61,16 @@
 	 */
 	#define K1B_JTLB_LENGTH 128
 
+	/**
+	 * @brief Associativity of Join TLB (number of ways).
+	 */
+	#define K1B_JTLB_WAYS 2
+
+	/**
+	 * @brief Number of sets in the Join TLB.
+	 */
+	#define K1B_JTLB_SETS (K1B_JTLB_LENGTH/K1B_JTLB_WAYS)
+
 	/**
 	 * @brief Offset of JTLB in the TLB (number of entries).
 	 */
@@ -76,6 +86,11 @@
 	 */
 	#define K1B_TLB_LENGTH (K1B_JTLB_LENGTH + K1B_LTLB_LENGTH)
 
+	/**
+	 * @brief Width of address space identifiers (in bits).
+	 */
+	#define K1B_TLB_ASID_BITS 9
+
 	/**
 	 * @brief TLB entry size (in bytes).
 	 */
@@ -267,6 +282,51 @@
 	 */
 	extern int k1b_tlb_inval(vaddr_t vaddr, unsigned shift, unsigned way);
 
+	/**
+	 * @brief Writes a range of TLB entries.
+	 *
+	 * @param vaddr      Start virtual address.
+	 * @param paddr      Start physical address.
+	 * @param npages     Number of pages.
+	 * @param shift      Page shift.
+	 * @param way        Target set-associative way.
+	 * @param protection Protection attributes.
+	 */
+	extern int k1b_tlb_write_range(
+			vaddr_t vaddr,
+			paddr_t paddr,
+			size_t npages,
+			unsigned shift,
+			unsigned way,
+			unsigned protection
+	);
+
+	/**
+	 * @brief Invalidates a range of TLB entries.
+	 *
+	 * @param vaddr  Start virtual address.
+	 * @param npages Number of pages.
+	 * @param shift  Page shift.
+	 * @param way    Target set-associative way.
+	 */
+	extern int k1b_tlb_inval_range(vaddr_t vaddr, size_t npages, unsigned shift, unsigned way);
+
+	/**
+	 * @brief Asserts if a core may cache a range in its TLB.
+	 *
+	 * @param coreid ID of the target core.
+	 * @param vaddr  Start virtual address.
+	 * @param npages Number of pages.
+	 */
+	extern int k1b_tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages);
+
+	/**
+	 * @brief Sets the address space identifier of the underlying core.
+	 *
+	 * @param asid Target address space identifier.
+	 */
+	extern int k1b_tlb_asid_set(unsigned asid);
+
 	/**
 	 * @brief Dumps a TLB entry.
 	 *
@@ -333,6 +393,11 @@
 	#define __tlb_write_fn        /**< tlb_write()         */
 	#define __tlb_inval_fn        /**< tlb_inval()         */
 	#define __tlb_flush_fn        /**< tlb_flush()         */
+	#define __tlb_sync_entry_fn   /**< tlb_sync_entry()    */
+	#define __tlb_write_range_fn  /**< tlb_write_range()   */
+	#define __tlb_inval_range_fn  /**< tlb_inval_range()   */
+	#define __tlb_may_cache_fn    /**< tlb_may_cache()     */
+	#define __tlb_asid_set_fn     /**< tlb_asid_set()      */
 	/**@}*/
 
 	/**
@@ -346,6 +411,11 @@
 	 */
 	#define TLB_LENGTH K1B_JTLB_LENGTH
 
+	/**
+	 * @brief Width of address space identifiers (in bits).
+	 */
+	#define TLB_ASID_BITS K1B_TLB_ASID_BITS
+
 	/**
 	 * @name TLB Types
 	 */
@@ -418,6 +488,46 @@
 		return (k1b_tlb_inval(vaddr, 12, 0));
 	}
 
+	/**
+	 * @see k1b_tlb_write_range()
+	 */
+	static inline int tlb_write_range(int tlb_type, vaddr_t vaddr, paddr_t paddr, size_t npages)
+	{
+		/* Invalid TLB type. */
+		if ((tlb_type != K1B_TLB_INSTRUCTION) && (tlb_type != K1B_TLB_DATA))
+			return (-EINVAL);
+
+		return (k1b_tlb_write_range(vaddr, paddr, npages, 12, 0, K1B_TLBE_PROT_RW));
+	}
+
+	/**
+	 * @see k1b_tlb_inval_range()
+	 */
+	static inline int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t npages)
+	{
+		/* Invalid TLB type. */
+		if ((tlb_type != K1B_TLB_INSTRUCTION) && (tlb_type != K1B_TLB_DATA))
+			return (-EINVAL);
+
+		return (k1b_tlb_inval_range(vaddr, npages, 12, 0));
+	}
+
+	/**
+	 * @see k1b_tlb_may_cache()
+	 */
+	static inline int tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages)
+	{
+		return (k1b_tlb_may_cache(coreid, vaddr, npages));
+	}
+
+	/**
+	 * @see k1b_tlb_asid_set()
+	 */
+	static inline int tlb_asid_set(unsigned asid)
+	{
+		return (k1b_tlb_asid_set(asid));
+	}
+
 	/**
 	 * @see k1b_tlb_flush().
 	 */
@@ -426,6 +536,23 @@
 		return (k1b_tlb_flush());
 	}
 
+	/**
+	 * @brief Flushes changes of a single TLB entry.
+	 *
+	 * JTLB entries are written to hardware as soon as they change,
+	 * thus there is nothing left to flush.
+	 */
+	static inline int tlb_sync_entry(int tlb_type, vaddr_t vaddr)
+	{
+		((void) vaddr);
+
+		/* Invalid TLB type. */
+		if ((tlb_type != K1B_TLB_INSTRUCTION) && (tlb_type != K1B_TLB_DATA))
+			return (-EINVAL);
+
+		return (0);
+	}
+
 /**@endcond*/
 
 #endif /* ARCH_CORE_K1B_TLB_H_ */
@@ -34,6 +34,8 @@
 		#error "or1k core not required"
 	#endif
 
+	#include <arch/core/or1k/atomic.h>
+	#include <arch/core/or1k/bitops.h>
 	#include <arch/core/or1k/cache.h>
 	#include <arch/core/or1k/clock.h>
 	#include <arch/core/or1k/core.h>
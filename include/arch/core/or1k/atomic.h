@@ -0,0 +1,350 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CORE_OR1K_ATOMIC_H_
+#define ARCH_CORE_OR1K_ATOMIC_H_
+
+/**
+ * @addtogroup or1k-core-atomic Atomic
+ * @ingroup or1k-core
+ *
+ * @brief or1k Atomic Operations
+ *
+ * Read-modify-write operations are built on top of the l.lwa/l.swa
+ * (load-link/store-conditional) pair.
+ */
+/**@{*/
+
+#ifndef _ASM_FILE_
+
+	#include <nanvix/const.h>
+	#include <stdint.h>
+
+	/**
+	 * @brief Atomically loads a word.
+	 *
+	 * @param ptr Target word.
+	 *
+	 * @returns The value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t or1k_atomic_load(const volatile uint32_t *ptr)
+	{
+		return (*ptr);
+	}
+
+	/**
+	 * @brief Atomically stores a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 */
+	static inline void or1k_atomic_store(volatile uint32_t *ptr, uint32_t val)
+	{
+		*ptr = val;
+	}
+
+	/**
+	 * @brief Atomically exchanges a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t or1k_atomic_xchg(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+
+		__asm__ __volatile__
+		(
+			"1:\n"
+			"	l.lwa %0, 0(%1)\n"
+			"	l.swa 0(%1), %2\n"
+			"	l.bnf 1b\n"
+			"	l.nop\n"
+			: "=&r" (old)
+			: "r" (ptr),
+			  "r" (val)
+			: "memory"
+		);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically compares and swaps a word.
+	 *
+	 * @param ptr    Target word.
+	 * @param oldval Expected value.
+	 * @param newval Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr. The
+	 * swap took place if and only if it equals @p oldval.
+	 */
+	static inline uint32_t or1k_atomic_cas(volatile uint32_t *ptr, uint32_t oldval, uint32_t newval)
+	{
+		uint32_t old;
+
+		__asm__ __volatile__
+		(
+			"1:\n"
+			"	l.lwa  %0, 0(%1)\n"
+			"	l.sfne %0, %2\n"
+			"	l.bf   2f\n"
+			"	l.nop\n"
+			"	l.swa  0(%1), %3\n"
+			"	l.bnf  1b\n"
+			"	l.nop\n"
+			"2:\n"
+			: "=&r" (old)
+			: "r" (ptr),
+			  "r" (oldval),
+			  "r" (newval)
+			: "memory"
+		);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically adds a value to a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to add.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t or1k_atomic_fetch_add(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		uint32_t tmp;
+
+		__asm__ __volatile__
+		(
+			"1:\n"
+			"	l.lwa %0, 0(%2)\n"
+			"	l.add %1, %0, %3\n"
+			"	l.swa 0(%2), %1\n"
+			"	l.bnf 1b\n"
+			"	l.nop\n"
+			: "=&r" (old),
+			  "=&r" (tmp)
+			: "r" (ptr),
+			  "r" (val)
+			: "memory"
+		);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically subtracts a value from a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to subtract.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t or1k_atomic_fetch_sub(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		uint32_t tmp;
+
+		__asm__ __volatile__
+		(
+			"1:\n"
+			"	l.lwa %0, 0(%2)\n"
+			"	l.sub %1, %0, %3\n"
+			"	l.swa 0(%2), %1\n"
+			"	l.bnf 1b\n"
+			"	l.nop\n"
+			: "=&r" (old),
+			  "=&r" (tmp)
+			: "r" (ptr),
+			  "r" (val)
+			: "memory"
+		);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically ORs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to OR.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t or1k_atomic_fetch_or(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		uint32_t tmp;
+
+		__asm__ __volatile__
+		(
+			"1:\n"
+			"	l.lwa %0, 0(%2)\n"
+			"	l.or %1, %0, %3\n"
+			"	l.swa 0(%2), %1\n"
+			"	l.bnf 1b\n"
+			"	l.nop\n"
+			: "=&r" (old),
+			  "=&r" (tmp)
+			: "r" (ptr),
+			  "r" (val)
+			: "memory"
+		);
+
+		return (old);
+	}
+
+	/**
+	 * @brief Atomically ANDs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to AND.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	static inline uint32_t or1k_atomic_fetch_and(volatile uint32_t *ptr, uint32_t val)
+	{
+		uint32_t old;
+		uint32_t tmp;
+
+		__asm__ __volatile__
+		(
+			"1:\n"
+			"	l.lwa %0, 0(%2)\n"
+			"	l.and %1, %0, %3\n"
+			"	l.swa 0(%2), %1\n"
+			"	l.bnf 1b\n"
+			"	l.nop\n"
+			: "=&r" (old),
+			  "=&r" (tmp)
+			: "r" (ptr),
+			  "r" (val)
+			: "memory"
+		);
+
+		return (old);
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond or1k
+ */
+
+	/**
+	 * @name Provided Interface
+	 */
+	/**@{*/
+	#define __atomic_load_fn      /**< atomic_load()      */
+	#define __atomic_store_fn     /**< atomic_store()     */
+	#define __atomic_xchg_fn      /**< atomic_xchg()      */
+	#define __atomic_cas_fn       /**< atomic_cas()       */
+	#define __atomic_fetch_add_fn /**< atomic_fetch_add() */
+	#define __atomic_fetch_sub_fn /**< atomic_fetch_sub() */
+	#define __atomic_fetch_or_fn  /**< atomic_fetch_or()  */
+	#define __atomic_fetch_and_fn /**< atomic_fetch_and() */
+	/**@}*/
+
+#ifndef _ASM_FILE_
+
+	/**
+	 * @see or1k_atomic_load().
+	 */
+	static inline uint32_t atomic_load(const volatile uint32_t *ptr)
+	{
+		return (or1k_atomic_load(ptr));
+	}
+
+	/**
+	 * @see or1k_atomic_store().
+	 */
+	static inline void atomic_store(volatile uint32_t *ptr, uint32_t val)
+	{
+		or1k_atomic_store(ptr, val);
+	}
+
+	/**
+	 * @see or1k_atomic_xchg().
+	 */
+	static inline uint32_t atomic_xchg(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (or1k_atomic_xchg(ptr, val));
+	}
+
+	/**
+	 * @see or1k_atomic_cas().
+	 */
+	static inline uint32_t atomic_cas(volatile uint32_t *ptr, uint32_t oldval, uint32_t newval)
+	{
+		return (or1k_atomic_cas(ptr, oldval, newval));
+	}
+
+	/**
+	 * @see or1k_atomic_fetch_add().
+	 */
+	static inline uint32_t atomic_fetch_add(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (or1k_atomic_fetch_add(ptr, val));
+	}
+
+	/**
+	 * @see or1k_atomic_fetch_sub().
+	 */
+	static inline uint32_t atomic_fetch_sub(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (or1k_atomic_fetch_sub(ptr, val));
+	}
+
+	/**
+	 * @see or1k_atomic_fetch_or().
+	 */
+	static inline uint32_t atomic_fetch_or(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (or1k_atomic_fetch_or(ptr, val));
+	}
+
+	/**
+	 * @see or1k_atomic_fetch_and().
+	 */
+	static inline uint32_t atomic_fetch_and(volatile uint32_t *ptr, uint32_t val)
+	{
+		return (or1k_atomic_fetch_and(ptr, val));
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@endcond*/
+
+#endif /* ARCH_CORE_OR1K_ATOMIC_H_ */
@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CORE_OR1K_BITOPS_H_
+#define ARCH_CORE_OR1K_BITOPS_H_
+
+/**
+ * @addtogroup or1k-core-bitops Bit Operations
+ * @ingroup or1k-core
+ *
+ * @brief or1k Bit Operations
+ */
+/**@{*/
+
+#ifndef _ASM_FILE_
+
+	#include <stdint.h>
+
+	/**
+	 * @brief Counts leading zero bits.
+	 *
+	 * @param x Target value.
+	 *
+	 * @returns The number of leading zero bits in @p x.
+	 *
+	 * @note @p x should not be zero.
+	 */
+	static inline int or1k_bit_clz(uint32_t x)
+	{
+		uint32_t pos;
+
+		/* Position of the last set bit, starting from one. */
+		__asm__ ("l.fl1 %0, %1" : "=r"(pos) : "r"(x));
+
+		return (32 - pos);
+	}
+
+	/**
+	 * @brief Counts trailing zero bits.
+	 *
+	 * @param x Target value.
+	 *
+	 * @returns The number of trailing zero bits in @p x.
+	 *
+	 * @note @p x should not be zero.
+	 */
+	static inline int or1k_bit_ctz(uint32_t x)
+	{
+		uint32_t pos;
+
+		/* Position of the first set bit, starting from one. */
+		__asm__ ("l.ff1 %0, %1" : "=r"(pos) : "r"(x));
+
+		return (pos - 1);
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond or1k
+ */
+
+	/**
+	 * @name Provided Functions
+	 */
+	/**@{*/
+	#define __bit_clz_fn /**< bit_clz() */
+	#define __bit_ctz_fn /**< bit_ctz() */
+	/**@}*/
+
+#ifndef _ASM_FILE_
+
+	/**
+	 * @see or1k_bit_clz().
+	 */
+	static inline int bit_clz(uint32_t x)
+	{
+		return (or1k_bit_clz(x));
+	}
+
+	/**
+	 * @see or1k_bit_ctz().
+	 */
+	static inline int bit_ctz(uint32_t x)
+	{
+		return (or1k_bit_ctz(x));
+	}
+
+#endif /* _ASM_FILE_ */
+
+/**@endcond*/
+
+#endif /* ARCH_CORE_OR1K_BITOPS_H_ */
@@ -37,6 +37,8 @@
 
 	#define __NEED_OR1K_REGS
 	#include <arch/core/or1k/regs.h>
+	#include <stddef.h>
+	#include <stdint.h>
 
 #endif /* _ASM_FILE_ */
 
@@ -57,6 +59,72 @@
 		or1k_mtspr(OR1K_SPR_DCBIR, 0);
 	}
 
+	/**
+	 * @brief Applies a cache block operation to a memory area.
+	 *
+	 * @param spr  Cache block SPR (DCBIR, DCBFR or DCBWR).
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 */
+	static inline void or1k_dcache_range(unsigned spr, const void *addr, size_t len)
+	{
+		uintptr_t start;
+		uintptr_t end;
+
+		if (len == 0)
+			return;
+
+		start = ((uintptr_t) addr) & ~(OR1K_CACHE_LINE_SIZE - 1);
+		end = ((uintptr_t) addr) + len;
+
+		for (uintptr_t line = start; line < end; line += OR1K_CACHE_LINE_SIZE)
+			or1k_mtspr(spr, line);
+	}
+
+	/**
+	 * @brief Invalidates a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 */
+	static inline void or1k_dcache_inval_range(const void *addr, size_t len)
+	{
+		or1k_dcache_range(OR1K_SPR_DCBIR, addr, len);
+	}
+
+	/**
+	 * @brief Writes back a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 */
+	static inline void or1k_dcache_flush_range(const void *addr, size_t len)
+	{
+		or1k_dcache_range(OR1K_SPR_DCBWR, addr, len);
+	}
+
+	/**
+	 * @brief Writes back and invalidates a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 */
+	static inline void or1k_dcache_flush_inval_range(const void *addr, size_t len)
+	{
+		or1k_dcache_range(OR1K_SPR_DCBFR, addr, len);
+	}
+
+	/**
+	 * @brief Memory barrier.
+	 *
+	 * Waits for all outstanding loads and stores to complete. Caches
+	 * are coherent, so this orders accesses for all barrier flavors.
+	 */
+	static inline void or1k_mb(void)
+	{
+		__asm__ __volatile__ ("l.msync" ::: "memory");
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -71,7 +139,15 @@
 	 * @name Provided Interface
 	 */
 	/**@{*/
-	#define __dcache_invalidate_fn /**< dcache_invalidate() */
+	#define __dcache_invalidate_fn              /**< dcache_invalidate()              */
+	#define __dcache_invalidate_range_fn        /**< dcache_invalidate_range()        */
+	#define __dcache_flush_range_fn             /**< dcache_flush_range()             */
+	#define __dcache_flush_invalidate_range_fn  /**< dcache_flush_invalidate_range()  */
+	#define __hal_mb_fn                         /**< hal_mb()                         */
+	#define __hal_rmb_fn                        /**< hal_rmb()                        */
+	#define __hal_wmb_fn                        /**< hal_wmb()                        */
+	#define __hal_acquire_fn                    /**< hal_acquire()                    */
+	#define __hal_release_fn                    /**< hal_release()                    */
 	/**@}*/
 
 	/**
@@ -87,6 +163,70 @@
 		or1k_dcache_inval();
 	}
 
+	/**
+	 * @see or1k_dcache_inval_range().
+	 */
+	static inline void dcache_invalidate_range(const void *addr, size_t len)
+	{
+		or1k_dcache_inval_range(addr, len);
+	}
+
+	/**
+	 * @see or1k_dcache_flush_range().
+	 */
+	static inline void dcache_flush_range(const void *addr, size_t len)
+	{
+		or1k_dcache_flush_range(addr, len);
+	}
+
+	/**
+	 * @see or1k_dcache_flush_inval_range().
+	 */
+	static inline void dcache_flush_invalidate_range(const void *addr, size_t len)
+	{
+		or1k_dcache_flush_inval_range(addr, len);
+	}
+
+	/**
+	 * @see or1k_mb().
+	 */
+	static inline void hal_mb(void)
+	{
+		or1k_mb();
+	}
+
+	/**
+	 * @see or1k_mb().
+	 */
+	static inline void hal_rmb(void)
+	{
+		or1k_mb();
+	}
+
+	/**
+	 * @see or1k_mb().
+	 */
+	static inline void hal_wmb(void)
+	{
+		or1k_mb();
+	}
+
+	/**
+	 * @see or1k_mb().
+	 */
+	static inline void hal_acquire(void)
+	{
+		or1k_mb();
+	}
+
+	/**
+	 * @see or1k_mb().
+	 */
+	static inline void hal_release(void)
+	{
+		or1k_mb();
+	}
+
 /**@endcond*/
 
 #endif /* ARCH_CORE_OR1K_CACHE_H_ */
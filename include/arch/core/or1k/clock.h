@@ -34,12 +34,18 @@
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <stdint.h>
 
 	/**
 	 * @brief Estimated CPU frequency (in Hz), 20Mhz/30Hz.
 	 */
 	#define OR1K_CPU_FREQUENCY 666666
 
+	/**
+	 * @brief Frequency of the tick timer (in Hz), 20Mhz.
+	 */
+	#define OR1K_CLOCK_FREQUENCY 20000000
+
 	/**
 	 * @brief Initializes the clock driver in the or1k architecture.
 	 *
@@ -52,6 +58,29 @@
 	 */
 	EXTERN void or1k_clock_ack(void);
 
+	/**
+	 * @brief Sets up the tick timer to run freely.
+	 */
+	EXTERN void or1k_clock_setup(void);
+
+	/**
+	 * @brief Reads the cycle counter.
+	 *
+	 * @returns The number of cycles elapsed in the tick timer of
+	 * the underlying core, extended to 64 bits.
+	 */
+	EXTERN uint64_t or1k_clock_read_cycles(void);
+
+	/**
+	 * @brief Gets the frequency of the cycle counter.
+	 *
+	 * @returns The frequency of the cycle counter (in Hz).
+	 */
+	static inline uint32_t or1k_clock_cycles_freq(void)
+	{
+		return (OR1K_CLOCK_FREQUENCY);
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -66,7 +95,9 @@
 	 * @name Provided Interface
 	 */
 	/**@{*/
-	#define __clock_init_fn /**< clock_init() */
+	#define __clock_init_fn        /**< clock_init()        */
+	#define __clock_read_cycles_fn /**< clock_read_cycles() */
+	#define __clock_cycles_freq_fn /**< clock_cycles_freq() */
 	/**@}*/
 
 	/**
@@ -82,6 +113,22 @@
 		or1k_clock_init(freq);
 	}
 
+	/**
+	 * @see or1k_clock_read_cycles().
+	 */
+	static inline uint64_t clock_read_cycles(void)
+	{
+		return (or1k_clock_read_cycles());
+	}
+
+	/**
+	 * @see or1k_clock_cycles_freq().
+	 */
+	static inline uint32_t clock_cycles_freq(void)
+	{
+		return (or1k_clock_cycles_freq());
+	}
+
 /**@endcond*/
 
 #endif /* ARCH_CORE_OR1K_CLOCK */
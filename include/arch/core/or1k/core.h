@@ -38,6 +38,8 @@
 
 #ifndef _ASM_FILE_
 
+	#include <arch/core/or1k/atomic.h>
+	#include <arch/core/or1k/cache.h>
 	#include <arch/core/or1k/spinlock.h>
 	#include <nanvix/const.h>
 	#include <stdint.h>
@@ -46,10 +48,22 @@
 
 #ifndef _ASM_FILE_
 
+	/**
+	 * @brief Pending IPIs of a core.
+	 *
+	 * Bit @e i of the mask is set when core @e i has sent a signal.
+	 * The mask is only accessed with atomic operations, and it takes
+	 * up a whole cache line, so that cores do not contend on it.
+	 */
+	struct or1k_ipis
+	{
+		uint32_t mask; /**< Pending IPIs. */
+	} ALIGN(OR1K_CACHE_LINE_SIZE);
+
 	/**
 	 * @brief Pending IPIs.
 	 */
-	EXTERN int pending_ipis[];
+	EXTERN struct or1k_ipis pending_ipis[];
 
 	/**
 	 * @brief Powers off the underlying core.
@@ -106,15 +120,8 @@
 	{
 		int mycoreid = or1k_core_get_id();
 
-		/*
-		 * Although pending_ipis should only be used
-		 * within a critical section, this is already
-		 * done by the caller function, hence, there's
-		 * no need to do locks here.
-		 */
-
 		/* Clear pending IPIs in the current core. */
-		pending_ipis[mycoreid] = 0;
+		or1k_atomic_store(&pending_ipis[mycoreid].mask, 0);
 	}
 
 	/**
@@ -134,7 +141,7 @@
 		int mycoreid = or1k_core_get_id();
 
 		/* Set the pending IPI flag. */
-		pending_ipis[coreid] |= (1 << mycoreid);
+		or1k_atomic_fetch_or(&pending_ipis[coreid].mask, 1 << mycoreid);
 	}
 
 #endif /* _ASM_FILE_ */
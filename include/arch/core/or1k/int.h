@@ -98,6 +98,35 @@
 		);
 	}
 
+	/**
+	 * @brief Disables hardware interrupts and saves their state.
+	 *
+	 * The or1k_hwint_save() function disables all hardware interrupts
+	 * in the underlying or1k core, and returns their previous state.
+	 *
+	 * @returns The previous state of hardware interrupts.
+	 *
+	 * @see or1k_hwint_restore().
+	 */
+	static inline uint32_t or1k_hwint_save(void)
+	{
+		uint32_t sr = or1k_mfspr(OR1K_SPR_SR);
+
+		or1k_mtspr(OR1K_SPR_SR, sr & ~(OR1K_SPR_SR_IEE | OR1K_SPR_SR_TEE));
+
+		return (sr & (OR1K_SPR_SR_IEE | OR1K_SPR_SR_TEE));
+	}
+
+	/**
+	 * @brief Restores the state of hardware interrupts.
+	 *
+	 * @param state State returned by or1k_hwint_save().
+	 */
+	static inline void or1k_hwint_restore(uint32_t state)
+	{
+		or1k_mtspr(OR1K_SPR_SR, or1k_mfspr(OR1K_SPR_SR) | state);
+	}
+
 	/**
 	 * @brief Sets a handler for a hardware interrupt.
 	 *
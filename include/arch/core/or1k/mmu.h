@@ -37,6 +37,8 @@
 
 	#define __NEED_MEMORY_TYPES
 	#include <arch/core/or1k/types.h>
+	#include <arch/core/or1k/atomic.h>
+	#include <arch/core/or1k/cache.h>
 
 	#include <nanvix/klib.h>
 	#include <errno.h>
@@ -235,6 +237,30 @@
 	EXTERN unsigned KSTART_CODE;
 	EXTERN unsigned KSTART_DATA;
 
+	/**
+	 * @brief Generation of page tables.
+	 *
+	 * Bumped whenever a present mapping is cleared or changed, so
+	 * that translation storage buffers drop their stale entries.
+	 */
+	EXTERN volatile uint32_t or1k_pgtab_gen;
+
+	/**
+	 * @brief Notifies a change in a present mapping.
+	 *
+	 * @param present Was the mapping present?
+	 *
+	 * @note Must be called after the change is made.
+	 */
+	static inline void or1k_pgtab_changed(int present)
+	{
+		if (present)
+		{
+			or1k_mb();
+			or1k_atomic_fetch_add(&or1k_pgtab_gen, 1);
+		}
+	}
+
 	/**
 	 * @brief Clears a page directory entry.
 	 *
@@ -242,11 +268,15 @@
 	 */
 	static inline int pde_clear(struct pde *pde)
 	{
+		int present; /* Was the mapping present? */
+
 		/* Invalid PDE. */
 		if (pde == NULL)
 			return (-EINVAL);
 
+		present = pde->present;
 		kmemset(pde, 0, PTE_SIZE);
+		or1k_pgtab_changed(present);
 
 		return (0);
 	}
@@ -259,6 +289,8 @@
 	 */
 	static inline int pde_frame_set(struct pde *pde, frame_t frame)
 	{
+		int present; /* Was the mapping present? */
+
 		/* Invalid PDE. */
 		if (pde == NULL)
 			return (-EINVAL);
@@ -267,7 +299,9 @@
 		if (frame > ~(frame_t)((1 << (VADDR_BIT - PAGE_SHIFT)) - 1))
 			return (-EINVAL);
 
+		present = pde->present;
 		pde->frame = frame;
+		or1k_pgtab_changed(present);
 
 		return (0);
 	}
@@ -280,11 +314,15 @@
 	 */
 	static inline int pde_present_set(struct pde *pde, int set)
 	{
+		int present; /* Was the mapping present? */
+
 		/* Invalid PDE. */
 		if (pde == NULL)
 			return (-EINVAL);
 
+		present = pde->present;
 		pde->present = (set) ? 1 : 0;
+		or1k_pgtab_changed(present && !set);
 
 		return (0);
 	}
@@ -394,11 +432,15 @@
 	 */
 	static inline int pte_clear(struct pte *pte)
 	{
+		int present; /* Was the mapping present? */
+
 		/* Invalid PTE. */
 		if (pte == NULL)
 			return (-EINVAL);
 
+		present = pte->present;
 		kmemset(pte, 0, PTE_SIZE);
+		or1k_pgtab_changed(present);
 
 		return (0);
 	}
@@ -411,11 +453,15 @@
 	 */
 	static inline int pte_present_set(struct pte *pte, int set)
 	{
+		int present; /* Was the mapping present? */
+
 		/* Invalid PTE. */
 		if (pte == NULL)
 			return (-EINVAL);
 
+		present = pte->present;
 		pte->present = (set) ? 1 : 0;
+		or1k_pgtab_changed(present && !set);
 
 		return (0);
 	}
@@ -447,6 +493,8 @@
 	 */
 	static inline int pte_frame_set(struct pte *pte, frame_t frame)
 	{
+		int present; /* Was the mapping present? */
+
 		/* Invalid PTE. */
 		if (pte == NULL)
 			return (-EINVAL);
@@ -455,7 +503,9 @@
 		if (frame > ~(frame_t)((1 << (VADDR_BIT - PAGE_SHIFT)) - 1))
 			return (-EINVAL);
 
+		present = pte->present;
 		pte->frame = frame;
+		or1k_pgtab_changed(present);
 
 		return (0);
 	}
@@ -33,6 +33,7 @@
 	/* External functions. */
 	EXTERN void or1k_ompic_init(void);
 	EXTERN void or1k_ompic_send_ipi(uint32_t dstcore, uint16_t data);
+	EXTERN void or1k_ompic_notify(int coreid);
 
 #endif /* _ASM_FILE_ */
 
@@ -33,11 +33,17 @@
  */
 /**@{*/
 
+#ifndef _ASM_FILE_
+
 	#define __NEED_MEMORY_TYPES
 	#include <arch/core/or1k/types.h>
+	#include <arch/core/or1k/int.h>
 	#include <arch/core/or1k/mmu.h>
+	#include <arch/core/or1k/ompic.h>
 	#include <errno.h>
 
+#endif /* _ASM_FILE_ */
+
 	/**
 	 * @name TLB Types
 	 */
@@ -56,6 +62,44 @@
 	 */
 	#define OR1K_TLBE_SIZE 8
 
+	/**
+	 * @brief Width of address space identifiers (in bits).
+	 */
+	#define OR1K_TLB_ASID_BITS 4
+
+	/**
+	 * @brief Log2 of the length of translation storage buffers.
+	 *
+	 * Build-time parameter, at most 16. Each core has one buffer
+	 * for each TLB type.
+	 */
+	#ifndef OR1K_TSB_SHIFT
+	#define OR1K_TSB_SHIFT 10
+	#endif
+
+	/* The refill fast path masks TSB indexes with an immediate. */
+	#if (OR1K_TSB_SHIFT > 16)
+	#error "OR1K_TSB_SHIFT should be at most 16"
+	#endif
+
+	/**
+	 * @brief Length of translation storage buffers (number of entries).
+	 */
+	#define OR1K_TSB_LENGTH (1 << OR1K_TSB_SHIFT)
+
+	/**
+	 * @name Translation Storage Buffer Statistics
+	 *
+	 * Layout of per-core statistics, which take one cache line each.
+	 */
+	/**@{*/
+	#define OR1K_TSB_STATS_SHIFT  6                          /**< Log2 of size.                */
+	#define OR1K_TSB_STATS_SIZE   (1 << OR1K_TSB_STATS_SHIFT) /**< Size (in bytes).             */
+	#define OR1K_TSB_STATS_GEN    0                          /**< Page table generation seen.  */
+	#define OR1K_TSB_STATS_HITS   4                          /**< Misses served by the buffer. */
+	#define OR1K_TSB_STATS_MISSES 8                          /**< Misses that walked.          */
+	/**@}*/
+
 	/**
 	 * @brief Valid bit
 	 */
@@ -123,6 +167,8 @@
 	#define OR1K_ITLBE_UXE 2 /**< User Execute Enable       */
 	/**@}*/
 
+#ifndef _ASM_FILE_
+
 	/**
 	 * @brief TLB entry.
 	 */
@@ -224,16 +270,79 @@
 	 */
 	EXTERN int or1k_tlb_inval(int tlb_type, vaddr_t vaddr);
 
+	/**
+	 * @brief Writes a range of TLB entries.
+	 *
+	 * @param tlb_type Target TLB.
+	 * @param vaddr    Start virtual address.
+	 * @param paddr    Start physical address.
+	 * @param npages   Number of pages.
+	 */
+	EXTERN int or1k_tlb_write_range(int tlb_type, vaddr_t vaddr, paddr_t paddr, size_t npages);
+
+	/**
+	 * @brief Invalidates a range of TLB entries.
+	 *
+	 * @param tlb_type Target TLB.
+	 * @param vaddr    Start virtual address.
+	 * @param npages   Number of pages.
+	 */
+	EXTERN int or1k_tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t npages);
+
 	/**
 	 * @brief Flushes the TLB.
 	 */
 	EXTERN int or1k_tlb_flush(void);
 
+	/**
+	 * @brief Writes back a single TLB entry to hardware.
+	 *
+	 * @param tlb_type Target TLB (D-TLB or I-TLB).
+	 * @param vaddr    Virtual address encoded by the target entry.
+	 *
+	 * @returns This function always returns zero.
+	 */
+	EXTERN int or1k_tlb_sync_entry(int tlb_type, vaddr_t vaddr);
+
+	/**
+	 * @brief Asserts if a core may cache a range in its TLB.
+	 *
+	 * @param coreid ID of the target core.
+	 * @param vaddr  Start virtual address.
+	 * @param npages Number of pages.
+	 */
+	EXTERN int or1k_tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages);
+
+	/**
+	 * @brief Sets the address space identifier of the underlying core.
+	 *
+	 * @param asid Target address space identifier.
+	 */
+	EXTERN int or1k_tlb_asid_set(unsigned asid);
+
+	/**
+	 * @brief Drops stale entries of the translation storage buffer.
+	 */
+	EXTERN void or1k_tlb_tsb_sync(void);
+
+	/**
+	 * @brief Gets statistics of the translation storage buffer.
+	 *
+	 * @param hits   Store location for the number of hits.
+	 * @param misses Store location for the number of misses.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int or1k_tlb_tsb_stats(unsigned *hits, unsigned *misses);
+
 	/**
 	 * @brief Initializes the TLB.
 	 */
 	EXTERN void or1k_tlb_init(void);
 
+#endif /* _ASM_FILE_ */
+
 /**@}*/
 
 /*============================================================================*
@@ -261,6 +370,12 @@
 	#define __tlb_write_fn        /**< tlb_write()         */
 	#define __tlb_inval_fn        /**< tlb_inval()         */
 	#define __tlb_flush_fn        /**< tlb_flush()         */
+	#define __tlb_sync_entry_fn   /**< tlb_sync_entry()    */
+	#define __tlb_write_range_fn  /**< tlb_write_range()   */
+	#define __tlb_inval_range_fn  /**< tlb_inval_range()   */
+	#define __tlb_may_cache_fn    /**< tlb_may_cache()     */
+	#define __tlb_asid_set_fn     /**< tlb_asid_set()      */
+	#define __tlb_notify_fn       /**< tlb_shootdown_notify() */
 	/**@}*/
 
 	/**
@@ -271,6 +386,11 @@
 	 */
 	#define TLB_LENGTH OR1K_TLB_LENGTH
 
+	/**
+	 * @brief Width of address space identifiers (in bits).
+	 */
+	#define TLB_ASID_BITS OR1K_TLB_ASID_BITS
+
 	/**
 	 * @name TLB Types
 	 */
@@ -279,6 +399,8 @@
 	#define TLB_DATA        OR1K_TLB_DATA        /**< Data TLB        */
 	/**@}*/
 
+#ifndef _ASM_FILE_
+
 	/**
 	 * @see or1k_tlbe_vaddr_get().
 	 */
@@ -343,6 +465,46 @@
 		return (or1k_tlb_inval(tlb_type, vaddr));
 	}
 
+	/**
+	 * @see or1k_tlb_write_range()
+	 */
+	static inline int tlb_write_range(int tlb_type, vaddr_t vaddr, paddr_t paddr, size_t npages)
+	{
+		/* Invalid TLB type. */
+		if ((tlb_type != OR1K_TLB_INSTRUCTION) && (tlb_type != OR1K_TLB_DATA))
+			return (-EINVAL);
+
+		return (or1k_tlb_write_range(tlb_type, vaddr, paddr, npages));
+	}
+
+	/**
+	 * @see or1k_tlb_inval_range()
+	 */
+	static inline int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t npages)
+	{
+		/* Invalid TLB type. */
+		if ((tlb_type != OR1K_TLB_INSTRUCTION) && (tlb_type != OR1K_TLB_DATA))
+			return (-EINVAL);
+
+		return (or1k_tlb_inval_range(tlb_type, vaddr, npages));
+	}
+
+	/**
+	 * @see or1k_tlb_may_cache()
+	 */
+	static inline int tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages)
+	{
+		return (or1k_tlb_may_cache(coreid, vaddr, npages));
+	}
+
+	/**
+	 * @see or1k_tlb_asid_set()
+	 */
+	static inline int tlb_asid_set(unsigned asid)
+	{
+		return (or1k_tlb_asid_set(asid));
+	}
+
 	/**
 	 * @see or1k_tlb_flush().
 	 */
@@ -351,6 +513,44 @@
 		return (or1k_tlb_flush());
 	}
 
+	/**
+	 * @see or1k_tlb_sync_entry().
+	 */
+	static inline int tlb_sync_entry(int tlb_type, vaddr_t vaddr)
+	{
+		/* Invalid TLB type. */
+		if ((tlb_type != OR1K_TLB_INSTRUCTION) && (tlb_type != OR1K_TLB_DATA))
+			return (-EINVAL);
+
+		return (or1k_tlb_sync_entry(tlb_type, vaddr));
+	}
+
+	/**
+	 * @see or1k_ompic_notify().
+	 */
+	static inline void tlb_shootdown_notify(int coreid)
+	{
+		or1k_ompic_notify(coreid);
+	}
+
+	/**
+	 * @see or1k_hwint_save().
+	 */
+	static inline unsigned tlb_shootdown_irq_save(void)
+	{
+		return (or1k_hwint_save());
+	}
+
+	/**
+	 * @see or1k_hwint_restore().
+	 */
+	static inline void tlb_shootdown_irq_restore(unsigned state)
+	{
+		or1k_hwint_restore(state);
+	}
+
+#endif /* _ASM_FILE_ */
+
 /**@endcond*/
 
 #endif /* ARCH_CORE_OR1K_TLB_H_ */
@@ -43,6 +43,8 @@
 	#define UART_ADDR         _UART_ADDR
 	#define UART_BAUD         115200
 	#define UART_IRQ          2
+	#define UART_FIFO_SIZE    16
+	#define UART_TXBUF_SIZE   1024
 	/**@}*/
 
 	/**
@@ -150,6 +152,19 @@
 	 */
 	extern void uart8250_write(const char *buf, size_t n);
 
+	/**
+	 * @brief Flushes the transmit ring of the 8250 device.
+	 */
+	extern void uart8250_flush(void);
+
+	/**
+	 * @brief Enables interrupt-driven transmission on the 8250 device.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int uart8250_irq_setup(void);
+
 /**@}*/
 
 #endif /* DRIVER_8250_H_ */
@@ -55,6 +55,16 @@
 		console_write(buf, n);
 	}
 
+	/**
+	 * @brief Flushes the standard output device.
+	 *
+	 * @note Console output is not buffered, thus there is nothing to
+	 * flush.
+	 */
+	static inline void qemu_i486pc_stdout_flush(void)
+	{
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -71,6 +81,7 @@
 	/**@{*/
 	#define __stdout_init_fn  /**< stdout_init()  */
 	#define __stdout_write_fn /**< stdout_write() */
+	#define __stdout_flush_fn /**< stdout_flush() */
 	/**@}*/
 
 	/**
@@ -89,6 +100,14 @@
 		qemu_i486pc_stdout_write(buf, n);
 	}
 
+	/**
+	 * @see qemu_i486pc_stdout_flush().
+	 */
+	static inline void stdout_flush(void)
+	{
+		qemu_i486pc_stdout_flush();
+	}
+
 /**@endcond*/
 
 #endif /* TARGET_QEMU_I486_PC_STDOUT_H_ */
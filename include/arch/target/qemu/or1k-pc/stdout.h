@@ -55,6 +55,22 @@
 		uart8250_write(buf, n);
 	}
 
+	/**
+	 * @see uart8250_flush()
+	 */
+	static inline void qemu_or1kpc_stdout_flush(void)
+	{
+		uart8250_flush();
+	}
+
+	/**
+	 * @see uart8250_irq_setup()
+	 */
+	static inline void qemu_or1kpc_stdout_irq_setup(void)
+	{
+		uart8250_irq_setup();
+	}
+
 /**@}*/
 
 /*============================================================================*
@@ -69,8 +85,10 @@
 	 * @name Provided Interface
 	 */
 	/**@{*/
-	#define __stdout_init_fn  /**< stdout_init()  */
-	#define __stdout_write_fn /**< stdout_write() */
+	#define __stdout_init_fn      /**< stdout_init()      */
+	#define __stdout_write_fn     /**< stdout_write()     */
+	#define __stdout_flush_fn     /**< stdout_flush()     */
+	#define __stdout_irq_setup_fn /**< stdout_irq_setup() */
 	/**@}*/
 
 	/**
@@ -89,6 +107,22 @@
 		qemu_or1kpc_stdout_write(buf, n);
 	}
 
+	/**
+	 * @see qemu_or1kpc_stdout_flush().
+	 */
+	static inline void stdout_flush(void)
+	{
+		qemu_or1kpc_stdout_flush();
+	}
+
+	/**
+	 * @see qemu_or1kpc_stdout_irq_setup().
+	 */
+	static inline void stdout_irq_setup(void)
+	{
+		qemu_or1kpc_stdout_irq_setup();
+	}
+
 /**@endcond*/
 
 #endif /* TARGET_QEMU_OR1K_PC_STDOUT_H_ */
@@ -32,6 +32,8 @@
 	/* Core Interface Implementation */
 	#include <nanvix/hal/core/_core.h>
 
+	#include <nanvix/hal/core/atomic.h>
+	#include <nanvix/hal/core/bitops.h>
 	#include <nanvix/hal/core/cache.h>
 	#include <nanvix/hal/core/clock.h>
 	#include <nanvix/hal/core/context.h>
@@ -134,6 +136,16 @@
 	#define CORE_OFFLINE   4 /**< Powered Off */
 	/**@}*/
 
+	/**
+	 * @brief Per-core data.
+	 *
+	 * Tags a structure that is instantiated once per core, in an
+	 * array indexed by core ID. The structure is padded to a cache
+	 * line boundary, so that cores never share a cache line when
+	 * updating their own instances.
+	 */
+	#define PERCORE ALIGN(CACHE_LINE_SIZE)
+
 	/**
 	 * @brief Core information.
 	 */
@@ -141,10 +153,10 @@
 	{
 		int initialized;     /**< Initialized?      */
 		int state;           /**< State.            */
-		int wakeups;         /**< Wakeup signals.   */
+		uint32_t wakeups;    /**< Wakeup signals.   */
 		void (*start)(void); /**< Starting routine. */
 		spinlock_t lock;     /**< Lock.             */
-	};
+	} PERCORE;
 
 	/**
 	 * @brief Cores table.
@@ -0,0 +1,173 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_ATOMIC_H_
+#define NANVIX_HAL_ATOMIC_H_
+
+	/* Core Interface Implementation */
+	#include <nanvix/hal/core/_core.h>
+
+/*============================================================================*
+ * Interface Implementation Checking                                          *
+ *============================================================================*/
+
+	/* Functions */
+	#ifndef __atomic_load_fn
+	#error "atomic_load() not defined?"
+	#endif
+	#ifndef __atomic_store_fn
+	#error "atomic_store() not defined?"
+	#endif
+	#ifndef __atomic_xchg_fn
+	#error "atomic_xchg() not defined?"
+	#endif
+	#ifndef __atomic_cas_fn
+	#error "atomic_cas() not defined?"
+	#endif
+	#ifndef __atomic_fetch_add_fn
+	#error "atomic_fetch_add() not defined?"
+	#endif
+	#ifndef __atomic_fetch_sub_fn
+	#error "atomic_fetch_sub() not defined?"
+	#endif
+	#ifndef __atomic_fetch_or_fn
+	#error "atomic_fetch_or() not defined?"
+	#endif
+	#ifndef __atomic_fetch_and_fn
+	#error "atomic_fetch_and() not defined?"
+	#endif
+
+/*============================================================================*
+ * Atomic Operations Interface                                                *
+ *============================================================================*/
+
+/**
+ * @addtogroup kernel-hal-core-atomic Atomic
+ * @ingroup kernel-hal-core
+ *
+ * @brief Atomic Operations HAL Interface
+ *
+ * All operations work on naturally aligned 32-bit words. Unless
+ * stated otherwise, read-modify-write operations are fully ordered.
+ */
+/**@{*/
+
+	#include <nanvix/hal/core/cache.h>
+	#include <nanvix/const.h>
+	#include <stdint.h>
+
+	/**
+	 * @name Memory Barriers
+	 *
+	 * Aliases for the memory barriers of the cache interface, so that
+	 * cores implement them only once.
+	 */
+	/**@{*/
+	#define atomic_mb()      hal_mb()      /**< Full memory barrier. */
+	#define atomic_acquire() hal_acquire() /**< Acquire barrier.     */
+	#define atomic_release() hal_release() /**< Release barrier.     */
+	/**@}*/
+
+	/**
+	 * @brief Atomically loads a word.
+	 *
+	 * @param ptr Target word.
+	 *
+	 * @returns The value of the word pointed to by @p ptr.
+	 */
+	EXTERN uint32_t atomic_load(const volatile uint32_t *ptr);
+
+	/**
+	 * @brief Atomically stores a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 */
+	EXTERN void atomic_store(volatile uint32_t *ptr, uint32_t val);
+
+	/**
+	 * @brief Atomically exchanges a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	EXTERN uint32_t atomic_xchg(volatile uint32_t *ptr, uint32_t val);
+
+	/**
+	 * @brief Atomically compares and swaps a word.
+	 *
+	 * @param ptr    Target word.
+	 * @param oldval Expected value.
+	 * @param newval Value to store.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr. The
+	 * swap took place if and only if it equals @p oldval.
+	 */
+	EXTERN uint32_t atomic_cas(volatile uint32_t *ptr, uint32_t oldval, uint32_t newval);
+
+	/**
+	 * @brief Atomically adds a value to a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to add.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	EXTERN uint32_t atomic_fetch_add(volatile uint32_t *ptr, uint32_t val);
+
+	/**
+	 * @brief Atomically subtracts a value from a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to subtract.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	EXTERN uint32_t atomic_fetch_sub(volatile uint32_t *ptr, uint32_t val);
+
+	/**
+	 * @brief Atomically ORs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to OR.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	EXTERN uint32_t atomic_fetch_or(volatile uint32_t *ptr, uint32_t val);
+
+	/**
+	 * @brief Atomically ANDs a value into a word.
+	 *
+	 * @param ptr Target word.
+	 * @param val Value to AND.
+	 *
+	 * @returns The old value of the word pointed to by @p ptr.
+	 */
+	EXTERN uint32_t atomic_fetch_and(volatile uint32_t *ptr, uint32_t val);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_ATOMIC_H_ */
@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_BITOPS_H_
+#define NANVIX_HAL_BITOPS_H_
+
+	/* Core Interface Implementation */
+	#include <nanvix/hal/core/_core.h>
+
+/*============================================================================*
+ * Interface Implementation Checking                                          *
+ *============================================================================*/
+
+	/* Functions */
+	#ifndef __bit_clz_fn
+	#error "bit_clz() not defined?"
+	#endif
+	#ifndef __bit_ctz_fn
+	#error "bit_ctz() not defined?"
+	#endif
+
+/*============================================================================*
+ * Bit Operations Interface                                                   *
+ *============================================================================*/
+
+/**
+ * @addtogroup kernel-hal-core-bitops Bit Operations
+ * @ingroup kernel-hal-core
+ *
+ * @brief Bit Operations HAL Interface
+ *
+ * Operations map to the bit scan instructions of the underlying core.
+ * Their result is undefined for a zero argument.
+ */
+/**@{*/
+
+	#include <nanvix/const.h>
+	#include <stdint.h>
+
+	/**
+	 * @brief Counts leading zero bits.
+	 *
+	 * @param x Target value.
+	 *
+	 * @returns The number of leading zero bits in @p x.
+	 */
+	EXTERN int bit_clz(uint32_t x);
+
+	/**
+	 * @brief Counts trailing zero bits.
+	 *
+	 * @param x Target value.
+	 *
+	 * @returns The number of trailing zero bits in @p x.
+	 */
+	EXTERN int bit_ctz(uint32_t x);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_BITOPS_H_ */
@@ -41,6 +41,30 @@
 	#ifndef __dcache_invalidate_fn
 	#error "dcache_invalidate() not defined?"
 	#endif
+	#ifndef __dcache_invalidate_range_fn
+	#error "dcache_invalidate_range() not defined?"
+	#endif
+	#ifndef __dcache_flush_range_fn
+	#error "dcache_flush_range() not defined?"
+	#endif
+	#ifndef __dcache_flush_invalidate_range_fn
+	#error "dcache_flush_invalidate_range() not defined?"
+	#endif
+	#ifndef __hal_mb_fn
+	#error "hal_mb() not defined?"
+	#endif
+	#ifndef __hal_rmb_fn
+	#error "hal_rmb() not defined?"
+	#endif
+	#ifndef __hal_wmb_fn
+	#error "hal_wmb() not defined?"
+	#endif
+	#ifndef __hal_acquire_fn
+	#error "hal_acquire() not defined?"
+	#endif
+	#ifndef __hal_release_fn
+	#error "hal_release() not defined?"
+	#endif
 
 /*============================================================================*
  * Cache Interface                                                             *
@@ -55,12 +79,93 @@
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <stddef.h>
 
 	/**
 	 * @brief Invalidates the data cache.
+	 *
+	 * @note This is an expensive operation. To order accesses to
+	 * shared memory, use the memory barriers instead.
 	 */
 	EXTERN void dcache_invalidate(void);
 
+	/**
+	 * @brief Invalidates a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 *
+	 * Drops the cache lines that overlap the target memory area, so
+	 * that subsequent loads fetch data written by other cores or
+	 * devices. Lines that are partially covered are dropped as well.
+	 */
+	EXTERN void dcache_invalidate_range(const void *addr, size_t len);
+
+	/**
+	 * @brief Flushes a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 *
+	 * Writes back the cache lines that overlap the target memory
+	 * area, so that other cores and devices see previous stores.
+	 */
+	EXTERN void dcache_flush_range(const void *addr, size_t len);
+
+	/**
+	 * @brief Flushes and invalidates a range of the data cache.
+	 *
+	 * @param addr Start address of the target memory area.
+	 * @param len  Length of the target memory area (in bytes).
+	 *
+	 * @see dcache_flush_range(), dcache_invalidate_range().
+	 */
+	EXTERN void dcache_flush_invalidate_range(const void *addr, size_t len);
+
+	/**
+	 * @brief Full memory barrier.
+	 *
+	 * Loads and stores that precede the barrier complete, and are
+	 * visible to other cores, before any load or store that follows
+	 * it.
+	 */
+	EXTERN void hal_mb(void);
+
+	/**
+	 * @brief Read memory barrier.
+	 *
+	 * Loads that precede the barrier complete before any load that
+	 * follows it. Loads that follow the barrier observe stores that
+	 * other cores have made visible with a write barrier.
+	 */
+	EXTERN void hal_rmb(void);
+
+	/**
+	 * @brief Write memory barrier.
+	 *
+	 * Stores that precede the barrier are visible to other cores
+	 * before any store that follows it.
+	 */
+	EXTERN void hal_wmb(void);
+
+	/**
+	 * @brief Acquire barrier.
+	 *
+	 * Issued after a load that acquires shared data, such as reading
+	 * a flag set by another core. Loads and stores that follow the
+	 * barrier are not performed before that load.
+	 */
+	EXTERN void hal_acquire(void);
+
+	/**
+	 * @brief Release barrier.
+	 *
+	 * Issued before a store that publishes shared data, such as
+	 * setting a flag read by another core. Loads and stores that
+	 * precede the barrier are performed before that store.
+	 */
+	EXTERN void hal_release(void);
+
 /**@}*/
 
 #endif /* HAL_CORE_CACHE_H_ */
@@ -41,6 +41,12 @@
 	#ifndef __clock_init_fn
 	#error "clock_init() not defined?"
 	#endif
+	#ifndef __clock_read_cycles_fn
+	#error "clock_read_cycles() not defined?"
+	#endif
+	#ifndef __clock_cycles_freq_fn
+	#error "clock_cycles_freq() not defined?"
+	#endif
 
 /*============================================================================*
  * Clock Device Interface                                                     *
@@ -55,6 +61,7 @@
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <stdint.h>
 
 	/**
 	 * @brief Initializes the hardware dependent clock driver.
@@ -63,6 +70,39 @@
 	 */
 	EXTERN void clock_init(unsigned freq);
 
+	/**
+	 * @brief Reads the cycle counter of the underlying core.
+	 *
+	 * @returns The number of cycles elapsed since some arbitrary
+	 * point in the past. The counter is monotonic and never wraps
+	 * around in practice.
+	 *
+	 * @note The counter is not synchronized across cores.
+	 */
+	EXTERN uint64_t clock_read_cycles(void);
+
+	/**
+	 * @brief Gets the frequency of the cycle counter.
+	 *
+	 * @returns The frequency of the cycle counter (in Hz).
+	 */
+	EXTERN uint32_t clock_cycles_freq(void);
+
+	/**
+	 * @brief Sets up the conversion of cycles to nanoseconds.
+	 *
+	 * @note This function is called by hal_init().
+	 */
+	EXTERN void clock_setup(void);
+
+	/**
+	 * @brief Reads the monotonic timestamp of the underlying core.
+	 *
+	 * @returns The number of nanoseconds elapsed since some arbitrary
+	 * point in the past.
+	 */
+	EXTERN uint64_t clock_read_ns(void);
+
 /**@}*/
 
 #endif /* NANVIX_HAL_CLOCK_H_ */
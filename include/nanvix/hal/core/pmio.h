@@ -39,13 +39,22 @@
 
 	#if (CORE_SUPPORTS_PMIO)
 
-		/* Functions */
+		/*
+		 * Functions. Input functions are optional, since
+		 * some cores can only write to their ports.
+		 */
 		#ifndef __output8_fn
 		#error "output8() not defined?"
 		#endif
 		#ifndef __output8s_fn
 		#error "output8s() not defined?"
 		#endif
+		#ifndef __output16s_fn
+		#error "output16s() not defined?"
+		#endif
+		#ifndef __output32s_fn
+		#error "output32s() not defined?"
+		#endif
 		#ifndef __iowait_fn
 		#error "iowait() not defined?"
 		#endif
@@ -67,6 +76,25 @@
 	#include <nanvix/const.h>
 	#include <stdint.h>
 
+	/**
+	 * @brief Reads 8 bits from an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 *
+	 * @returns The bits that were read. On cores that cannot read
+	 * from their ports, zero is returned.
+	 */
+#if (CORE_SUPPORTS_PMIO) && defined(__input8_fn)
+	EXTERN uint8_t input8(uint16_t port);
+#else
+	static inline uint8_t input8(uint16_t port)
+	{
+		((void) port);
+
+		return (0);
+	}
+#endif
+
 	/**
 	 * @brief Writes 8 bits to an I/O port.
 	 *
@@ -82,6 +110,28 @@
 		((void) bits);
 	}
 #endif
+
+	/**
+	 * @brief Reads a 8-bit string from an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  Target 8-bit string.
+	 * @param len  Length of the string.
+	 *
+	 * On cores that cannot read from their ports, @p str is left
+	 * untouched.
+	 */
+#if (CORE_SUPPORTS_PMIO) && defined(__input8s_fn)
+	EXTERN void input8s(uint16_t port, uint8_t *str, size_t len);
+#else
+	static inline void input8s(uint16_t port, uint8_t *str, size_t len)
+	{
+		((void) port);
+		((void) str);
+		((void) len);
+	}
+#endif
+
 	/**
 	 * @brief Writes a 8-bit string to an I/O port.
 	 *
@@ -100,6 +150,42 @@
 	}
 #endif
 
+	/**
+	 * @brief Writes a 16-bit string to an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  16-bit string to write.
+	 * @param len  Length of the string (in 16-bit words).
+	 */
+#if (CORE_SUPPORTS_PMIO)
+	EXTERN void output16s(uint16_t port, const uint16_t *str, size_t len);
+#else
+	static inline void output16s(uint16_t port, const uint16_t *str, size_t len)
+	{
+		((void) port);
+		((void) str);
+		((void) len);
+	}
+#endif
+
+	/**
+	 * @brief Writes a 32-bit string to an I/O port.
+	 *
+	 * @param port Number of the target port.
+	 * @param str  32-bit string to write.
+	 * @param len  Length of the string (in 32-bit words).
+	 */
+#if (CORE_SUPPORTS_PMIO)
+	EXTERN void output32s(uint16_t port, const uint32_t *str, size_t len);
+#else
+	static inline void output32s(uint16_t port, const uint32_t *str, size_t len)
+	{
+		((void) port);
+		((void) str);
+		((void) len);
+	}
+#endif
+
 	/**
 	 * @brief Waits for an operation in an I/O port to complete.
 	 *
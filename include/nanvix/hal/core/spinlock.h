@@ -44,6 +44,12 @@
 	#ifndef __spinlock_t
 	#error "spinlock_t not defined?"
 	#endif
+	#ifndef __rwlock_t
+	#error "rwlock_t not defined?"
+	#endif
+	#ifndef __seqlock_t
+	#error "seqlock_t not defined?"
+	#endif
 
 	/* Functions */
 	#ifndef __spinlock_init_fn
@@ -58,6 +64,187 @@
 	#ifndef __spinlock_unlock_fn
 	#error "spinlock_unlock() not defined?"
 	#endif
+	#if defined(__ticketlock_t)
+		#ifndef __ticketlock_init_fn
+		#error "ticketlock_init() not defined?"
+		#endif
+		#ifndef __ticketlock_lock_fn
+		#error "ticketlock_lock() not defined?"
+		#endif
+		#ifndef __ticketlock_trylock_fn
+		#error "ticketlock_trylock() not defined?"
+		#endif
+		#ifndef __ticketlock_unlock_fn
+		#error "ticketlock_unlock() not defined?"
+		#endif
+	#endif
+	#if defined(__qspinlock_t)
+		#ifndef __qspinlock_init_fn
+		#error "qspinlock_init() not defined?"
+		#endif
+		#ifndef __qspinlock_lock_fn
+		#error "qspinlock_lock() not defined?"
+		#endif
+		#ifndef __qspinlock_trylock_fn
+		#error "qspinlock_trylock() not defined?"
+		#endif
+		#ifndef __qspinlock_unlock_fn
+		#error "qspinlock_unlock() not defined?"
+		#endif
+	#endif
+	#ifndef __rwlock_init_fn
+	#error "rwlock_init() not defined?"
+	#endif
+	#ifndef __rwlock_read_lock_fn
+	#error "rwlock_read_lock() not defined?"
+	#endif
+	#ifndef __rwlock_read_unlock_fn
+	#error "rwlock_read_unlock() not defined?"
+	#endif
+	#ifndef __rwlock_write_lock_fn
+	#error "rwlock_write_lock() not defined?"
+	#endif
+	#ifndef __rwlock_write_unlock_fn
+	#error "rwlock_write_unlock() not defined?"
+	#endif
+	#ifndef __seqlock_init_fn
+	#error "seqlock_init() not defined?"
+	#endif
+	#ifndef __seqlock_write_lock_fn
+	#error "seqlock_write_lock() not defined?"
+	#endif
+	#ifndef __seqlock_write_unlock_fn
+	#error "seqlock_write_unlock() not defined?"
+	#endif
+	#ifndef __seqlock_read_begin_fn
+	#error "seqlock_read_begin() not defined?"
+	#endif
+	#ifndef __seqlock_read_retry_fn
+	#error "seqlock_read_retry() not defined?"
+	#endif
+	#ifndef SPINLOCK_TRYLOCK_OK
+	#error "SPINLOCK_TRYLOCK_OK() not defined"
+	#endif
+
+/*============================================================================*
+ * Fair Spinlocks                                                             *
+ *============================================================================*/
+
+	#include <nanvix/hal/core/atomic.h>
+	#include <nanvix/hal/core/cache.h>
+	#include <nanvix/const.h>
+	#include <stdint.h>
+
+	/*
+	 * Ticket and queue spinlocks are built on top of the atomic
+	 * operations interface, unless the underlying core provides
+	 * its own.
+	 */
+
+#if !defined(__ticketlock_t)
+
+	/**
+	 * @brief Ticket lock.
+	 *
+	 * Waiters are served in FIFO order.
+	 */
+	typedef struct
+	{
+		volatile uint32_t next;  /**< Next ticket to hand out. */
+		volatile uint32_t owner; /**< Ticket being served.     */
+	} ticketlock_t;
+
+	/**
+	 * @see ticketlock_init().
+	 */
+	static inline void ticketlock_init(ticketlock_t *lock)
+	{
+		lock->next = 0;
+		lock->owner = 0;
+	}
+
+	/**
+	 * @see ticketlock_trylock().
+	 */
+	static inline int ticketlock_trylock(ticketlock_t *lock)
+	{
+		uint32_t owner;
+
+		owner = atomic_load(&lock->owner);
+
+		/* Take a ticket only if it is served right away. */
+		if (atomic_cas(&lock->next, owner, owner + 1) != owner)
+			return (1);
+
+		hal_acquire();
+		return (0);
+	}
+
+	/**
+	 * @see ticketlock_lock().
+	 */
+	static inline void ticketlock_lock(ticketlock_t *lock)
+	{
+		uint32_t ticket;
+
+		ticket = atomic_fetch_add(&lock->next, 1);
+
+		while (atomic_load(&lock->owner) != ticket)
+			/* noop */;
+
+		hal_acquire();
+	}
+
+	/**
+	 * @see ticketlock_unlock().
+	 */
+	static inline void ticketlock_unlock(ticketlock_t *lock)
+	{
+		hal_release();
+		atomic_store(&lock->owner, lock->owner + 1);
+	}
+
+#endif
+
+#if !defined(__qspinlock_t)
+
+	/**
+	 * @brief Maximum number of queue spinlocks held at once by a core.
+	 */
+	#define QSPINLOCK_NESTING 4
+
+	/**
+	 * @brief Queue node of a MCS spinlock.
+	 *
+	 * Each core owns QSPINLOCK_NESTING nodes, each one in its own
+	 * cache line, and spins only on the node that it has enqueued.
+	 */
+	struct qspinlock_node
+	{
+		struct qspinlock_node *volatile next; /**< Next waiter.   */
+		volatile uint32_t locked;             /**< Still waiting? */
+		uint32_t busy;                        /**< Node in use?   */
+	} ALIGN(CACHE_LINE_SIZE);
+
+	/**
+	 * @brief Queue (MCS) spinlock.
+	 */
+	typedef struct
+	{
+		volatile uint32_t tail;       /**< Address of last node in the queue. */
+		struct qspinlock_node *owner; /**< Node of the lock holder.           */
+	} qspinlock_t;
+
+	/**
+	 * @see qspinlock_init().
+	 */
+	static inline void qspinlock_init(qspinlock_t *lock)
+	{
+		lock->tail = 0;
+		lock->owner = NULL;
+	}
+
+#endif
 
 /*============================================================================*
  * Spinlocks Interface                                                        *
@@ -68,10 +255,26 @@
  * @ingroup kernel-hal-core
  *
  * @brief Spinlocks HAL Interface
+ *
+ * Besides the plain test-and-set spinlock_t, two fair locks are
+ * provided for contended paths: a ticketlock_t, which serves waiters in
+ * FIFO order, and a qspinlock_t (MCS lock), in which each core spins on
+ * a node of its own, in a private cache line.
+ *
+ * For read-mostly data, a rwlock_t lets readers in parallel and a
+ * seqlock_t lets readers run without writing to shared memory at all.
+ * A seqlock_t reader goes like this:
+ *
+ *   do
+ *   {
+ *       seq = seqlock_read_begin(&lock);
+ *       ... read data ...
+ *   } while (seqlock_read_retry(&lock, seq));
  */
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <stdint.h>
 
 	/**
 	 * @brief Initializes a spinlock.
@@ -106,6 +309,228 @@
 	 */
 	EXTERN void spinlock_unlock(spinlock_t *lock);
 
+	/**
+	 * @brief Initializes a ticket lock.
+	 *
+	 * @param lock Target ticket lock.
+	 */
+	EXTERN void ticketlock_init(ticketlock_t *lock);
+
+	/**
+	 * @brief Locks a ticket lock.
+	 *
+	 * @param lock Target ticket lock.
+	 */
+	EXTERN void ticketlock_lock(ticketlock_t *lock);
+
+	/**
+	 * @brief Attempts to lock a ticket lock.
+	 *
+	 * @param lock Target ticket lock.
+	 *
+	 * @returns The same as spinlock_trylock().
+	 */
+	EXTERN int ticketlock_trylock(ticketlock_t *lock);
+
+	/**
+	 * @brief Unlocks a ticket lock.
+	 *
+	 * @param lock Target ticket lock.
+	 */
+	EXTERN void ticketlock_unlock(ticketlock_t *lock);
+
+	/**
+	 * @brief Initializes a queue spinlock.
+	 *
+	 * @param lock Target queue spinlock.
+	 */
+	EXTERN void qspinlock_init(qspinlock_t *lock);
+
+	/**
+	 * @brief Locks a queue spinlock.
+	 *
+	 * @param lock Target queue spinlock.
+	 */
+	EXTERN void qspinlock_lock(qspinlock_t *lock);
+
+	/**
+	 * @brief Attempts to lock a queue spinlock.
+	 *
+	 * @param lock Target queue spinlock.
+	 *
+	 * @returns The same as spinlock_trylock().
+	 */
+	EXTERN int qspinlock_trylock(qspinlock_t *lock);
+
+	/**
+	 * @brief Unlocks a queue spinlock.
+	 *
+	 * @param lock Target queue spinlock.
+	 */
+	EXTERN void qspinlock_unlock(qspinlock_t *lock);
+
+	/**
+	 * @brief Initializes a reader-writer spinlock.
+	 *
+	 * @param lock Target reader-writer spinlock.
+	 */
+	EXTERN void rwlock_init(rwlock_t *lock);
+
+	/**
+	 * @brief Locks a reader-writer spinlock for reading.
+	 *
+	 * @param lock Target reader-writer spinlock.
+	 */
+	EXTERN void rwlock_read_lock(rwlock_t *lock);
+
+	/**
+	 * @brief Unlocks a reader-writer spinlock locked for reading.
+	 *
+	 * @param lock Target reader-writer spinlock.
+	 */
+	EXTERN void rwlock_read_unlock(rwlock_t *lock);
+
+	/**
+	 * @brief Locks a reader-writer spinlock for writing.
+	 *
+	 * @param lock Target reader-writer spinlock.
+	 */
+	EXTERN void rwlock_write_lock(rwlock_t *lock);
+
+	/**
+	 * @brief Unlocks a reader-writer spinlock locked for writing.
+	 *
+	 * @param lock Target reader-writer spinlock.
+	 */
+	EXTERN void rwlock_write_unlock(rwlock_t *lock);
+
+	/**
+	 * @brief Initializes a sequence lock.
+	 *
+	 * @param lock Target sequence lock.
+	 */
+	EXTERN void seqlock_init(seqlock_t *lock);
+
+	/**
+	 * @brief Locks a sequence lock for writing.
+	 *
+	 * @param lock Target sequence lock.
+	 */
+	EXTERN void seqlock_write_lock(seqlock_t *lock);
+
+	/**
+	 * @brief Unlocks a sequence lock locked for writing.
+	 *
+	 * @param lock Target sequence lock.
+	 */
+	EXTERN void seqlock_write_unlock(seqlock_t *lock);
+
+	/**
+	 * @brief Begins a read-side critical section of a sequence lock.
+	 *
+	 * @param lock Target sequence lock.
+	 *
+	 * @returns A sequence number to be handed to seqlock_read_retry().
+	 */
+	EXTERN uint32_t seqlock_read_begin(seqlock_t *lock);
+
+	/**
+	 * @brief Ends a read-side critical section of a sequence lock.
+	 *
+	 * @param lock Target sequence lock.
+	 * @param seq  Sequence number returned by seqlock_read_begin().
+	 *
+	 * @returns Non-zero if the read-side critical section should be
+	 * retried, and zero otherwise.
+	 */
+	EXTERN int seqlock_read_retry(seqlock_t *lock, uint32_t seq);
+
+/**@}*/
+
+/*============================================================================*
+ * Lock Statistics                                                            *
+ *============================================================================*/
+
+/**
+ * @addtogroup kernel-hal-core-lockstat Lock Statistics
+ * @ingroup kernel-hal-core-spinlock
+ *
+ * @brief Lock-Contention Profiling
+ *
+ * When the HAL is built with HAL_LOCKSTAT defined, spinlock_lock(),
+ * spinlock_trylock() and spinlock_unlock() are replaced by wrappers
+ * that record, per core and per call site, acquisitions, contended
+ * acquisitions, cycles spent spinning and cycles the lock was held.
+ * Otherwise, nothing is compiled in.
+ */
+/**@{*/
+
+#if defined(HAL_LOCKSTAT)
+
+	/**
+	 * @brief Maximum number of lock sites tracked per core.
+	 */
+	#define LOCKSTAT_SITES_MAX 32
+
+	/**
+	 * @brief Maximum number of locks held at once by a core.
+	 */
+	#define LOCKSTAT_DEPTH_MAX 8
+
+	/**
+	 * @brief Locks a spinlock and records statistics.
+	 *
+	 * @param lock Target spinlock.
+	 * @param file Source file of the call site.
+	 * @param line Source line of the call site.
+	 */
+	EXTERN void lockstat_spinlock_lock(spinlock_t *lock, const char *file, int line);
+
+	/**
+	 * @brief Attempts to lock a spinlock and records statistics.
+	 *
+	 * @param lock Target spinlock.
+	 * @param file Source file of the call site.
+	 * @param line Source line of the call site.
+	 *
+	 * @returns The same as spinlock_trylock().
+	 */
+	EXTERN int lockstat_spinlock_trylock(spinlock_t *lock, const char *file, int line);
+
+	/**
+	 * @brief Unlocks a spinlock and records statistics.
+	 *
+	 * @param lock Target spinlock.
+	 */
+	EXTERN void lockstat_spinlock_unlock(spinlock_t *lock);
+
+	/**
+	 * @brief Dumps lock statistics.
+	 */
+	EXTERN void lockstat_dump(void);
+
+	/**
+	 * @name Wrappers
+	 *
+	 * @note Use (spinlock_lock)() and friends to bypass them.
+	 */
+	/**@{*/
+	#define spinlock_lock(lock)    lockstat_spinlock_lock(lock, __FILE__, __LINE__)
+	#define spinlock_trylock(lock) lockstat_spinlock_trylock(lock, __FILE__, __LINE__)
+	#define spinlock_unlock(lock)  lockstat_spinlock_unlock(lock)
+	/**@}*/
+
+#else
+
+	/**
+	 * @brief Dumps lock statistics.
+	 */
+	static inline void lockstat_dump(void)
+	{
+	}
+
+#endif
+
 /**@}*/
 
 #endif /* NANVIX_HAL_SPINLOCK_H_ */
@@ -80,6 +80,24 @@
 		#ifndef __tlb_inval_fn
 			#error "tlb_inval() not defined?"
 		#endif
+		#ifndef __tlb_sync_entry_fn
+			#error "tlb_sync_entry() not defined?"
+		#endif
+		#ifndef __tlb_write_range_fn
+			#error "tlb_write_range() not defined?"
+		#endif
+		#ifndef __tlb_inval_range_fn
+			#error "tlb_inval_range() not defined?"
+		#endif
+		#ifndef __tlb_may_cache_fn
+			#error "tlb_may_cache() not defined?"
+		#endif
+		#ifndef __tlb_asid_set_fn
+			#error "tlb_asid_set() not defined?"
+		#endif
+		#ifndef TLB_ASID_BITS
+			#error "TLB_ASID_BITS not defined!"
+		#endif
 
 	#endif
 
@@ -96,6 +114,7 @@
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <errno.h>
 
 	/**
 	 * @brief Casts something to a virtual address.
@@ -121,6 +140,13 @@
 	#define TLB_DATA        1 /**< Data TLB        */
 	/**@}*/
 
+	/**
+	 * @brief Width of address space identifiers (in bits).
+	 */
+	#ifndef TLB_ASID_BITS
+	#define TLB_ASID_BITS 0
+	#endif
+
 #endif
 
 	/**
@@ -221,6 +247,8 @@
 	 * @param tlb_type Target TLB (D-TLB or I-TLB).
 	 * @param vaddr    Target virtual address.
 	 *
+	 * The invalidation takes effect right away, without tlb_flush().
+	 *
 	 * @returns Upon successful completion, zero is returned. Upon
 	 * failure, a negative error code is returned instead.
 	 */
@@ -244,6 +272,327 @@
 	 */
 	EXTERN int tlb_flush(void);
 
+	/**
+	 * @brief Flushes changes of a single TLB entry.
+	 *
+	 * @param tlb_type Target TLB (D-TLB or I-TLB).
+	 * @param vaddr    Target virtual address.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+#if !((defined(TLB_HARDWARE) && !defined(__tlb_sync_entry_fn)))
+	EXTERN int tlb_sync_entry(int tlb_type, vaddr_t vaddr);
+#else
+	static inline int tlb_sync_entry(int tlb_type, vaddr_t vaddr)
+	{
+		((void) tlb_type);
+		((void) vaddr);
+
+		return (0);
+	}
+#endif
+
+	/**
+	 * @brief Encodes a range of virtual addresses into the TLB.
+	 *
+	 * @param tlb_type Target TLB (D-TLB or I-TLB).
+	 * @param vaddr    Start virtual address.
+	 * @param paddr    Start physical address.
+	 * @param npages   Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+#if !((defined(TLB_HARDWARE) && !defined(__tlb_write_range_fn)))
+	EXTERN int tlb_write_range(int tlb_type, vaddr_t vaddr, paddr_t paddr, size_t npages);
+#else
+	static inline int tlb_write_range(int tlb_type, vaddr_t vaddr, paddr_t paddr, size_t npages)
+	{
+		((void) tlb_type);
+		((void) vaddr);
+		((void) paddr);
+		((void) npages);
+
+		return (0);
+	}
+#endif
+
+	/**
+	 * @brief Invalidates a range of virtual addresses in the TLB.
+	 *
+	 * @param tlb_type Target TLB (D-TLB or I-TLB).
+	 * @param vaddr    Start virtual address.
+	 * @param npages   Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+#if !((defined(TLB_HARDWARE) && !defined(__tlb_inval_range_fn)))
+	EXTERN int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t npages);
+#else
+	static inline int tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t npages)
+	{
+		((void) tlb_type);
+		((void) vaddr);
+		((void) npages);
+
+		return (tlb_flush());
+	}
+#endif
+
+	/**
+	 * @brief Asserts if a core may cache a range in its TLB.
+	 *
+	 * @param coreid ID of the target core.
+	 * @param vaddr  Start virtual address.
+	 * @param npages Number of pages.
+	 *
+	 * @returns Zero if no entry of the TLB of the core @p coreid
+	 * encodes a page in the target range, and non-zero if some entry
+	 * may do so.
+	 */
+#if !((defined(TLB_HARDWARE) && !defined(__tlb_may_cache_fn)))
+	EXTERN int tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages);
+#else
+	static inline int tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages)
+	{
+		((void) coreid);
+		((void) vaddr);
+		((void) npages);
+
+		return (1);
+	}
+#endif
+
+	/**
+	 * @brief Maximum number of operations in a TLB batch.
+	 */
+	#define TLB_BATCH_LENGTH 16
+
+	/**
+	 * @name TLB Batch Operations
+	 */
+	/**@{*/
+	#define TLB_BATCH_WRITE 0 /**< Write range.      */
+	#define TLB_BATCH_INVAL 1 /**< Invalidate range. */
+	/**@}*/
+
+	/**
+	 * @brief TLB batch.
+	 *
+	 * Accumulates TLB operations, so that they are committed at once.
+	 * Operations on contiguous ranges are merged as they are added.
+	 */
+	struct tlb_batch
+	{
+		int nops; /**< Number of pending operations. */
+
+		/**
+		 * @brief Pending operations.
+		 */
+		struct
+		{
+			int op;        /**< Operation.             */
+			int tlb_type;  /**< Target TLB.            */
+			vaddr_t vaddr; /**< Start virtual address. */
+			paddr_t paddr; /**< Start physical address. */
+			size_t npages; /**< Number of pages.       */
+		} ops[TLB_BATCH_LENGTH];
+	};
+
+	/**
+	 * @brief Initializes a TLB batch.
+	 *
+	 * @param batch Target batch.
+	 */
+	EXTERN void tlb_batch_init(struct tlb_batch *batch);
+
+	/**
+	 * @brief Adds a range write to a TLB batch.
+	 *
+	 * @param batch    Target batch.
+	 * @param tlb_type Target TLB (D-TLB or I-TLB).
+	 * @param vaddr    Start virtual address.
+	 * @param paddr    Start physical address.
+	 * @param npages   Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int tlb_batch_write(
+		struct tlb_batch *batch,
+		int tlb_type,
+		vaddr_t vaddr,
+		paddr_t paddr,
+		size_t npages
+	);
+
+	/**
+	 * @brief Adds a range invalidation to a TLB batch.
+	 *
+	 * @param batch    Target batch.
+	 * @param tlb_type Target TLB (D-TLB or I-TLB).
+	 * @param vaddr    Start virtual address.
+	 * @param npages   Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int tlb_batch_inval(
+		struct tlb_batch *batch,
+		int tlb_type,
+		vaddr_t vaddr,
+		size_t npages
+	);
+
+	/**
+	 * @brief Commits a TLB batch.
+	 *
+	 * @param batch Target batch.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int tlb_batch_commit(struct tlb_batch *batch);
+
+	/**
+	 * @brief Address space identifier.
+	 *
+	 * Holds the ASID assigned to an address space, along with the
+	 * generation in which it was assigned. ASIDs of old generations
+	 * are stale and are reassigned on the next switch.
+	 */
+	struct tlb_asid
+	{
+		uint32_t id; /**< Generation and ASID (zero if unassigned). */
+	};
+
+	/**
+	 * @brief Sets the address space identifier of the calling core.
+	 *
+	 * @param asid Target address space identifier.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+#if !((defined(TLB_HARDWARE) && !defined(__tlb_asid_set_fn)))
+	EXTERN int tlb_asid_set(unsigned asid);
+#else
+	static inline int tlb_asid_set(unsigned asid)
+	{
+		return ((asid < (1u << TLB_ASID_BITS)) ? 0 : -EINVAL);
+	}
+#endif
+
+	/**
+	 * @brief Initializes an address space identifier.
+	 *
+	 * @param asid Target address space identifier.
+	 */
+	EXTERN void tlb_asid_init(struct tlb_asid *asid);
+
+	/**
+	 * @brief Switches the TLB of the calling core to an address space.
+	 *
+	 * @param asid Address space identifier of the target address space.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+#if !((defined(TLB_HARDWARE) && !defined(__tlb_asid_set_fn)))
+	EXTERN int tlb_switch_asid(struct tlb_asid *asid);
+#else
+	static inline int tlb_switch_asid(struct tlb_asid *asid)
+	{
+		((void) asid);
+
+		return (0);
+	}
+#endif
+
+	/**
+	 * @brief Maximum number of cores targeted by a TLB shootdown.
+	 */
+	#define TLB_SHOOTDOWN_CORES_MAX 32
+
+	/**
+	 * @brief Maximum number of pending requests in a shootdown mailbox.
+	 *
+	 * When a mailbox overflows, the target core invalidates its
+	 * whole TLB.
+	 */
+	#define TLB_SHOOTDOWN_LENGTH 8
+
+	/**
+	 * @brief TLB shootdown token.
+	 *
+	 * Tracks the acknowledgments of a posted TLB shootdown.
+	 */
+	struct tlb_shootdown_token
+	{
+		uint32_t coremask;                         /**< Pending cores.   */
+		uint32_t tickets[TLB_SHOOTDOWN_CORES_MAX]; /**< Ticket per core. */
+	};
+
+	/**
+	 * @brief Initializes the TLB shootdown mailboxes.
+	 */
+	EXTERN void tlb_shootdown_setup(void);
+
+	/**
+	 * @brief Invalidates a range in the TLB of several cores.
+	 *
+	 * @param coremask Target cores.
+	 * @param vaddr    Start virtual address.
+	 * @param npages   Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned, once all
+	 * target cores have invalidated the range. Upon failure, a
+	 * negative error code is returned instead.
+	 */
+	EXTERN int tlb_shootdown(uint32_t coremask, vaddr_t vaddr, size_t npages);
+
+	/**
+	 * @brief Posts a TLB shootdown without waiting for it.
+	 *
+	 * @param coremask Target cores.
+	 * @param vaddr    Start virtual address.
+	 * @param npages   Number of pages.
+	 * @param token    Store location for the shootdown token.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	EXTERN int tlb_shootdown_post(
+		uint32_t coremask,
+		vaddr_t vaddr,
+		size_t npages,
+		struct tlb_shootdown_token *token
+	);
+
+	/**
+	 * @brief Collects acknowledgments of a TLB shootdown.
+	 *
+	 * @param token Target shootdown token.
+	 *
+	 * @returns Non-zero if all target cores have acknowledged the
+	 * shootdown, and zero otherwise.
+	 */
+	EXTERN int tlb_shootdown_done(struct tlb_shootdown_token *token);
+
+	/**
+	 * @brief Waits for a TLB shootdown to complete.
+	 *
+	 * @param token Target shootdown token.
+	 */
+	EXTERN void tlb_shootdown_wait(struct tlb_shootdown_token *token);
+
+	/**
+	 * @brief Handles TLB shootdown requests sent to the calling core.
+	 */
+	EXTERN void tlb_shootdown_handle(void);
+
 /**@}*/
 
 #endif /* HAL_CORE_TLB_H_ */
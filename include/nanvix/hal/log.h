@@ -31,9 +31,12 @@
 /**@{*/
 
 	#include <nanvix/const.h>
+	#include <stdint.h>
 
 	/**
-	 * @brief Size of log (in bytes).
+	 * @brief Size of the log of a core (in bytes).
+	 *
+	 * @note This should be a power of two.
 	 */
 	#define HAL_LOG_SIZE 512
 
@@ -50,6 +53,47 @@
 	 */
 	EXTERN void hal_log_write(const char *, size_t);
 
+	/**
+	 * @brief Number of binary records in the log of a core.
+	 *
+	 * @note This should be a power of two.
+	 */
+	#define HAL_LOG_RECORDS 32
+
+	/**
+	 * @brief Number of arguments of a binary record.
+	 */
+	#define HAL_LOG_RECORD_ARGS 4
+
+	/**
+	 * @brief Writes a binary record to the HAL log.
+	 *
+	 * @param fmt  Format string.
+	 * @param args Arguments (HAL_LOG_RECORD_ARGS words).
+	 *
+	 * The record is timestamped and formatted only when the log is
+	 * drained.
+	 */
+	EXTERN void hal_log_record(const char *fmt, const uint32_t *args);
+
+	/**
+	 * @brief Reads a binary record from the HAL log.
+	 *
+	 * @param buf  Target buffer.
+	 * @param size Size of the target buffer.
+	 *
+	 * The oldest record of the underlying core is popped, and written
+	 * to @p buf as it would be output by hal_log_drain().
+	 */
+	EXTERN int hal_log_read(char *buf, size_t size);
+
+	/**
+	 * @brief Drains the HAL log to the standard output device.
+	 *
+	 * @note This should be called when the underlying core is idle.
+	 */
+	EXTERN void hal_log_drain(void);
+
 /**@}*/
 
 #endif /* NANVIX_HAL_LOG_H_ */
@@ -33,6 +33,7 @@
 #define NANVIX_HAL_RESOURCE_H_
 
 	#include <nanvix/const.h>
+	#include <stdint.h>
 
 	/**
 	 * @brief Resource flags.
@@ -53,14 +54,28 @@
 		int flags; /**< Flags. */
 	};
 
+	/**
+	 * @brief Number of words in the allocation bitmap of a pool.
+	 *
+	 * @param n Number of resources in the pool.
+	 */
+	#define RESOURCE_BITMAP_LENGTH(n) (((n) + 31) >> 5)
+
 	/**
 	 * @brief Resource pool.
+	 *
+	 * A pool may be backed by an allocation bitmap, with one bit per
+	 * resource that is set if the resource is in use. Bitmap-backed
+	 * pools are allocated lock-free, whereas pools without a bitmap
+	 * fall back to a linear scan on resource flags.
 	 */
 	struct resource_pool
 	{
-		void *resources;	  /**< Pool of resources.       */
-		int nresources;		  /**< Number of resources.     */
-		size_t resource_size; /**< Resource size (in byes). */
+		void *resources;           /**< Pool of resources.            */
+		int nresources;            /**< Number of resources.          */
+		size_t resource_size;      /**< Resource size (in byes).      */
+		volatile uint32_t *bitmap; /**< Allocation bitmap (optional). */
+		volatile uint32_t *hint;   /**< Next bitmap word to search.   */
 	};
 
 	/**
@@ -50,6 +50,9 @@
 		#ifndef __stdout_write_fn
 		#error "stdout_write() not defined?"
 		#endif
+		#ifndef __stdout_flush_fn
+		#error "stdout_flush() not defined?"
+		#endif
 
 	#endif
 
@@ -92,6 +95,34 @@
 	}
 #endif
 
+	/**
+	 * @brief Flushes the standard output device.
+	 *
+	 * Blocks until all data previously written to the standard output
+	 * device has been handed to the underlying hardware.
+	 */
+#if (TARGET_HAS_STDOUT)
+	EXTERN void stdout_flush(void);
+#else
+	static inline void stdout_flush(void)
+	{
+	}
+#endif
+
+	/**
+	 * @brief Switches the standard output device to interrupt-driven mode.
+	 *
+	 * Should be called once the interrupt system is initialized.
+	 * Devices that do not support it keep being polled.
+	 */
+#if (TARGET_HAS_STDOUT) && defined(__stdout_irq_setup_fn)
+	EXTERN void stdout_irq_setup(void);
+#else
+	static inline void stdout_irq_setup(void)
+	{
+	}
+#endif
+
 /**@}*/
 
 #endif /* HAL_TARGET_STDOUT_H_ */
@@ -27,6 +27,7 @@
 
 	#include <nanvix/const.h>
 	#include <stdarg.h>
+	#include <stdint.h>
 
 /**
  * @defgroup klib Kernel Library
@@ -67,8 +68,69 @@
 	/* Forward definitions. */
 	EXTERN void kprintf(const char *, ...);
 	EXTERN int kvsprintf(char *, const char *, va_list);
+	EXTERN int kvsnprintf(char *, size_t, const char *, va_list);
 	EXTERN void kmemdump(const void *, size_t);
 
+	/**
+	 * @brief Maximum number of arguments of klog().
+	 */
+	#define KLOG_ARGS_MAX 4
+
+	/**
+	 * @brief Counts the arguments that follow the format string.
+	 *
+	 * The count is picked from a list of tokens, and then pasted to a
+	 * prefix. Only the tokens for zero up to KLOG_ARGS_MAX arguments
+	 * paste to a defined macro. With one argument too many, the picked
+	 * token pastes to an undeclared identifier. With more, one of the
+	 * arguments is picked instead, which either fails to paste, pastes
+	 * to an undeclared identifier, or is one of the tokens above, that
+	 * are not valid C expressions. Hence, any count above
+	 * KLOG_ARGS_MAX fails to compile.
+	 */
+	/**@{*/
+	#define __KLOG_NARGS_0_ 0
+	#define __KLOG_NARGS_1_ 1
+	#define __KLOG_NARGS_2_ 2
+	#define __KLOG_NARGS_3_ 3
+	#define __KLOG_NARGS_4_ 4
+	#define __KLOG_NARGS_PASTE(n) __KLOG_NARGS_ ## n
+	#define __KLOG_NARGS_CHECK(n) __KLOG_NARGS_PASTE(n)
+	#define __KLOG_NARGS(_0, _1, _2, _3, _4, _5, n, ...) n
+	#define KLOG_NARGS(...)                     \
+		__KLOG_NARGS_CHECK(__KLOG_NARGS(        \
+			__VA_ARGS__,                        \
+			klog_error_too_many_arguments,      \
+			4_, 3_, 2_, 1_, 0_, 0_              \
+		))
+	/**@}*/
+
+	/**
+	 * @brief Logs a formatted message, deferring formatting.
+	 *
+	 * Only the format string pointer and up to KLOG_ARGS_MAX argument
+	 * words are recorded, so this is cheap enough for interrupt and
+	 * exception paths. The message is formatted when the HAL log is
+	 * drained. Hence, the format string and any string argument must
+	 * outlive the call, as string literals do.
+	 *
+	 * @note When the HAL log is drained, the text output of a core
+	 * comes before its klog() messages, regardless of the order in
+	 * which they were logged. Use the timestamp of klog() messages to
+	 * relate them to the text output.
+	 */
+	#define klog(...) klog_write(KLOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+
+	/**
+	 * @brief Records a message in the binary log.
+	 *
+	 * @param nargs Number of arguments.
+	 * @param fmt   Format string.
+	 *
+	 * @see klog().
+	 */
+	EXTERN void klog_write(int nargs, const char *fmt, ...);
+
 /**@}*/
 
 /*============================================================================*
@@ -100,8 +162,39 @@
  */
 /**@{*/
 
+	/**
+	 * @brief Transfer unit of the memory routines.
+	 *
+	 * Cores that feature native 64-bit loads and stores move double
+	 * words, the others move words.
+	 */
+	#if defined(__k1b__)
+		typedef uint64_t __attribute__((__may_alias__)) kword_t;
+	#else
+		typedef uint32_t __attribute__((__may_alias__)) kword_t;
+	#endif
+
+	/**
+	 * @brief Size of a transfer unit (in bytes).
+	 */
+	#define KWORD_SIZE sizeof(kword_t)
+
+	/**
+	 * @brief Asserts if two addresses agree on word alignment.
+	 *
+	 * @param a First address.
+	 * @param b Second address.
+	 *
+	 * @returns Non-zero if @p a and @p b have the same offset within
+	 * a transfer unit, and zero otherwise.
+	 */
+	#define KWORD_CONGRUENT(a, b) \
+		(((((uintptr_t) (a)) ^ ((uintptr_t) (b))) & (KWORD_SIZE - 1)) == 0)
+
 	/* Forward definitions. */
 	EXTERN void *kmemcpy(void *, const void *, size_t);
+	EXTERN void *kmemcpy_coherent(void *, const void *, size_t);
+	EXTERN void *kmemmove(void *, const void *, size_t);
 	EXTERN void *kmemset(void *, int, size_t);
 
 	/**
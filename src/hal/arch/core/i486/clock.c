@@ -23,8 +23,191 @@
  */
 
 #include <nanvix/const.h>
+#include <nanvix/klib.h>
 #include <arch/core/i486/8253.h>
 #include <arch/core/i486/pmio.h>
+#include <stdint.h>
+
+/**
+ * @brief Frequency used to calibrate the TSC (in Hz).
+ */
+#define I486_CLOCK_CALIBRATE_FREQ 100
+
+/**
+ * @name CPUID Feature Flags
+ */
+/**@{*/
+#define I486_EFLAGS_ID  0x00200000 /**< CPUID instruction available. */
+#define I486_CPUID_TSC  0x00000010 /**< Time-Stamp Counter present.  */
+/**@}*/
+
+/**
+ * @brief Is the Time-Stamp Counter present?
+ */
+PRIVATE int i486_clock_has_tsc = 0;
+
+/**
+ * @brief Frequency of the cycle counter (in Hz).
+ */
+PRIVATE uint32_t i486_clock_freq = PIT_FREQUENCY;
+
+/**
+ * @brief Extended PIT count (used when no TSC is present).
+ */
+PRIVATE uint64_t i486_clock_cycles = 0;
+
+/**
+ * @brief Last PIT count read (used when no TSC is present).
+ */
+PRIVATE uint16_t i486_clock_last = 0;
+
+/**
+ * @brief Reads the Time-Stamp Counter.
+ *
+ * @returns The value of the Time-Stamp Counter.
+ */
+static inline uint64_t i486_rdtsc(void)
+{
+	uint32_t lo, hi;
+
+	__asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
+
+	return ((((uint64_t) hi) << 32) | lo);
+}
+
+/**
+ * @brief Asserts if the Time-Stamp Counter is present.
+ *
+ * @returns Non-zero if the Time-Stamp Counter is present and zero
+ * otherwise.
+ */
+PRIVATE int i486_tsc_probe(void)
+{
+	uint32_t eflags0, eflags1;
+	uint32_t eax, ebx, ecx, edx;
+
+	/* The CPUID instruction is available iff EFLAGS.ID may be toggled. */
+	__asm__ __volatile__ (
+		"pushfl\n"
+		"pushfl\n"
+		"popl %0\n"
+		"movl %0, %1\n"
+		"xorl %2, %0\n"
+		"pushl %0\n"
+		"popfl\n"
+		"pushfl\n"
+		"popl %0\n"
+		"popfl\n"
+		: "=&r"(eflags0), "=&r"(eflags1)
+		: "i"(I486_EFLAGS_ID)
+	);
+
+	if (!((eflags0 ^ eflags1) & I486_EFLAGS_ID))
+		return (0);
+
+	/* Standard feature flags not supported. */
+	__asm__ __volatile__ ("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(0));
+	if (eax < 1)
+		return (0);
+
+	__asm__ __volatile__ ("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1));
+
+	return ((edx & I486_CPUID_TSC) != 0);
+}
+
+/**
+ * @brief Latches the count of channel 2 of the PIT.
+ *
+ * @returns The current count of channel 2 of the PIT.
+ */
+PRIVATE uint16_t i486_pit_latch(void)
+{
+	uint8_t lo, hi;
+
+	/* Send control byte: latch channel 2. */
+	i486_output8(PIT_CTRL, 0x80);
+
+	lo = i486_input8(PIT_DATA2);
+	hi = i486_input8(PIT_DATA2);
+
+	return ((uint16_t) ((hi << 8) | lo));
+}
+
+/**
+ * The i486_clock_setup() function sets up the cycle counter of the
+ * underlying i486 core. If the Time-Stamp Counter is present, it is
+ * calibrated against a one-shot count of channel 2 of the PIT.
+ * Otherwise, channel 2 of the PIT is set to run freely and its count
+ * is extended in software.
+ */
+PUBLIC void i486_clock_setup(void)
+{
+	uint8_t gate;
+
+	/* Enable gate of channel 2, but keep speaker off. */
+	gate = i486_input8(PIT_GATE);
+	gate = (gate & ~PIT_GATE_SPEAKER) | PIT_GATE_ENABLE;
+	i486_output8(PIT_GATE, gate);
+
+	i486_clock_has_tsc = i486_tsc_probe();
+
+	if (i486_clock_has_tsc)
+	{
+		uint64_t t0, t1;
+		uint16_t count;
+
+		count = PIT_FREQUENCY/I486_CLOCK_CALIBRATE_FREQ;
+
+		/* Send control byte: channel 2, one-shot. */
+		i486_output8(PIT_CTRL, 0xb0);
+		i486_output8(PIT_DATA2, (uint8_t)(count & 0xff));
+		i486_output8(PIT_DATA2, (uint8_t)((count >> 8)));
+
+		t0 = i486_rdtsc();
+		while (!(i486_input8(PIT_GATE) & PIT_GATE_OUT))
+			noop();
+		t1 = i486_rdtsc();
+
+		i486_clock_freq = (uint32_t)(t1 - t0)*I486_CLOCK_CALIBRATE_FREQ;
+	}
+	else
+	{
+		/* Send control byte: channel 2, rate generator. */
+		i486_output8(PIT_CTRL, 0xb4);
+		i486_output8(PIT_DATA2, 0);
+		i486_output8(PIT_DATA2, 0);
+
+		i486_clock_last = i486_pit_latch();
+	}
+}
+
+/**
+ * The i486_clock_read_cycles() function reads the cycle counter of
+ * the underlying i486 core.
+ */
+PUBLIC uint64_t i486_clock_read_cycles(void)
+{
+	uint16_t count;
+
+	if (i486_clock_has_tsc)
+		return (i486_rdtsc());
+
+	/* PIT counts down. */
+	count = i486_pit_latch();
+	i486_clock_cycles += (uint16_t)(i486_clock_last - count);
+	i486_clock_last = count;
+
+	return (i486_clock_cycles);
+}
+
+/**
+ * The i486_clock_cycles_freq() function returns the frequency of the
+ * cycle counter of the underlying i486 core.
+ */
+PUBLIC uint32_t i486_clock_cycles_freq(void)
+{
+	return (i486_clock_freq);
+}
 
 /**
  * The i486_clock_init() function initializes the clock driver in the
@@ -105,7 +105,7 @@ PUBLIC void do_excp(const struct exception *excp, const struct context *ctx)
 	if (i486_excp_handlers[excp->num] == NULL)
 		generic_excp_handler(excp, ctx);
 
-	kprintf("forwarding exception");
+	klog("[hal] forwarding exception %d", excp->num);
 
 	i486_excp_handlers[excp->num](excp, ctx);
 }
@@ -23,16 +23,18 @@
  */
 
 #include <nanvix/const.h>
+#include <arch/core/i486/8253.h>
 #include <arch/core/i486/gdt.h>
 #include <arch/core/i486/idt.h>
 #include <arch/core/i486/tss.h>
 
 /**
- * Initializes the GDT, TSS and IDT.
+ * Initializes the GDT, TSS, IDT and the cycle counter.
  */
 PUBLIC void i486_core_setup(void)
 {
 	gdt_setup();
 	tss_setup();
 	idt_setup();
+	i486_clock_setup();
 }
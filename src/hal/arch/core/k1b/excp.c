@@ -169,7 +169,7 @@ PUBLIC int k1b_excp_set_handler(int num, k1b_exception_handler_fn handler)
 		return (-EBUSY);
 
 	k1b_excp_handlers[num] = handler;
-	k1b_dcache_inval();
+	k1b_dcache_flush_range(&k1b_excp_handlers[num], sizeof(k1b_excp_handlers[num]));
 
 	return (0);
 }
@@ -194,7 +194,7 @@ PUBLIC int k1b_excp_unset_handler(int num)
 		return (-EINVAL);
 
 	k1b_excp_handlers[num] = NULL;
-	k1b_dcache_inval();
+	k1b_dcache_flush_range(&k1b_excp_handlers[num], sizeof(k1b_excp_handlers[num]));
 
 	return (0);
 }
@@ -84,7 +84,7 @@ PUBLIC int k1b_hwint_handler_set(int num, void (*handler)(int))
 		return (-EINVAL);
 
 	k1b_handlers[num] = handler;
-	k1b_dcache_inval();
+	k1b_dcache_flush_range(&k1b_handlers[num], sizeof(k1b_handlers[num]));
 
 	return (0);
 }
@@ -46,7 +46,7 @@ void hal_jtag_write(const uint8_t *buf, size_t n)
 
 	k = (n > K1B_BUFSIZE) ? K1B_BUFSIZE : n;
 
-	kmemcpy(jtag_buf, (const char *)buf, k);
+	kmemcpy_coherent(jtag_buf, (const char *)buf, k);
 
 	__k1_club_syscall2(__NR_jtag_write, (unsigned) jtag_buf, k);
 }
@@ -23,6 +23,7 @@
  */
 
 #include <arch/cluster/k1b/cores.h>
+#include <arch/cluster/k1b/memory.h>
 #include <nanvix/const.h>
 #include <errno.h>
 
@@ -60,6 +61,20 @@ PRIVATE struct
 	 * translation.
 	 */
 	struct tlbe ltlb[K1B_LTLB_LENGTH];
+
+	/**
+	 * @brief Regions that may be cached in the JTLB.
+	 *
+	 * Bit i is set once a page in a page table region congruent to i
+	 * is written to the JTLB, and is only cleared on initialization.
+	 * Other cores read it to skip TLB shootdowns.
+	 */
+	volatile uint32_t regions;
+
+	/**
+	 * @brief Current address space identifier.
+	 */
+	unsigned asid;
 } __attribute__((aligned(K1B_CACHE_LINE_SIZE))) tlb[K1B_CLUSTER_NUM_CORES];
 
 /*============================================================================*
@@ -146,27 +161,36 @@ PUBLIC int k1b_tlb_flush(void)
  * The k1b_tlb_lookup_vaddr() function searches the architectural TLB
  * for an entry that matches the virtual address @p vaddr.
  *
- * @todo Search in the JTLB may be performed using a faster method
- * based on tag lookup.
+ * A page is encoded in the JTLB only in the set selected by the
+ * virtual address bits right above its page size, thus only the
+ * ways of that set are probed for each supported page size.
  *
  * @author Pedro Henrique Penna
  */
 PUBLIC const struct tlbe *k1b_tlb_lookup_vaddr(vaddr_t vaddr)
 {
 	int coreid;
+	unsigned set;
 	const struct tlbe *tlbe;
+	static const unsigned shifts[2] = {K1B_PAGE_SHIFT, K1B_HUGE_PAGE_SHIFT};
 
 	coreid = k1b_core_get_id();
 
 	/* Search in JTLB. */
-	for (int i = 0; i < K1B_JTLB_LENGTH; i++)
+	for (int i = 0; i < 2; i++)
 	{
-		tlbe = &tlb[coreid].jtlb[i];
+		set = (vaddr >> shifts[i]) & (K1B_JTLB_SETS - 1);
 
-		/* Found */
-		if (k1b_tlbe_vaddr_get(tlbe) == vaddr)
+		for (int j = 0; j < K1B_JTLB_WAYS; j++)
 		{
-			if (tlbe->status != K1B_TLBE_STATUS_INVALID)
+			tlbe = &tlb[coreid].jtlb[K1B_JTLB_WAYS*set + j];
+
+			if (tlbe->status == K1B_TLBE_STATUS_INVALID)
+				continue;
+
+			/* Found */
+			if ((k1b_tlbe_vaddr_get(tlbe) == vaddr) &&
+				(k1b_tlbe_pgsize_get(tlbe) == (1u << shifts[i])))
 				return (tlbe);
 		}
 	}
@@ -257,8 +281,10 @@ PUBLIC int k1b_tlb_write(
 	struct tlbe tlbe;
 	__k1_tlb_entry_t _tlbe;
 
+	coreid = k1b_core_get_id();
+
 	tlbe.addr_ext = 0;
-	tlbe.addrspace = 0;
+	tlbe.addrspace = tlb[coreid].asid;
 	tlbe.cache_policy = K1B_DTLBE_CACHE_POLICY_WRTHROUGH;
 	tlbe.frame = paddr >> 12;
 	tlbe.global = 1;
@@ -267,11 +293,13 @@ PUBLIC int k1b_tlb_write(
 	tlbe.size = (shift == 12) ? 1 : 0;
 	tlbe.status = K1B_TLBE_STATUS_AMODIFIED;
 
-	coreid = k1b_core_get_id();
-	idx = 2*((vaddr >> shift) & 0x3f) + way;
+	idx = K1B_JTLB_WAYS*((vaddr >> shift) & (K1B_JTLB_SETS - 1)) + way;
 
 	kmemcpy(&_tlbe, &tlbe, K1B_TLBE_SIZE);
 
+	/* Publish region before the entry may be used. */
+	tlb[coreid].regions |= (1u << ((vaddr >> K1B_PGTAB_SHIFT) & 31));
+
 	/* Write to hardware TLB. */
 	if (mOS_mem_write_jtlb(_tlbe, way) != 0)
 	{
@@ -308,7 +336,7 @@ PUBLIC int k1b_tlb_inval(vaddr_t vaddr, unsigned shift, unsigned way)
 	tlbe.status = K1B_TLBE_STATUS_INVALID;
 
 	coreid = k1b_core_get_id();
-	idx = 2*((vaddr >> shift) & 0x3f) + way;
+	idx = K1B_JTLB_WAYS*((vaddr >> shift) & (K1B_JTLB_SETS - 1)) + way;
 
 	kmemcpy(&_tlbe, &tlbe, K1B_TLBE_SIZE);
 
@@ -324,6 +352,195 @@ PUBLIC int k1b_tlb_inval(vaddr_t vaddr, unsigned shift, unsigned way)
 	return (0);
 }
 
+/*============================================================================*
+ * k1b_tlb_write_range()                                                      *
+ *============================================================================*/
+
+/**
+ * The k1b_tlb_write_range() function writes @p npages contiguous
+ * mappings of size 2^@p shift, starting at @p vaddr and @p paddr,
+ * into the JTLB. Only the last @p K1B_JTLB_SETS pages of the range
+ * could survive in the target way, thus the pages before them are
+ * skipped.
+ */
+PUBLIC int k1b_tlb_write_range(
+		vaddr_t vaddr,
+		paddr_t paddr,
+		size_t npages,
+		unsigned shift,
+		unsigned way,
+		unsigned protection
+)
+{
+	int ret;
+	size_t skip;
+
+	skip = (npages > K1B_JTLB_SETS) ? npages - K1B_JTLB_SETS : 0;
+
+	for (size_t i = skip; i < npages; i++)
+	{
+		ret = k1b_tlb_write(
+			vaddr + (i << shift),
+			paddr + (i << shift),
+			shift,
+			way,
+			protection
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * k1b_tlb_inval_range()                                                      *
+ *============================================================================*/
+
+/**
+ * The k1b_tlb_inval_range() function invalidates the JTLB entries
+ * that encode the @p npages pages of size 2^@p shift starting at
+ * @p vaddr. If the range spans more pages than there are sets, each
+ * set is visited once and its ways are invalidated if they fall in
+ * the range.
+ */
+PUBLIC int k1b_tlb_inval_range(vaddr_t vaddr, size_t npages, unsigned shift, unsigned way)
+{
+	int ret;
+	int coreid;
+	vaddr_t start;
+	const struct tlbe *tlbe;
+
+	/* Small range. */
+	if (npages <= K1B_JTLB_SETS)
+	{
+		for (size_t i = 0; i < npages; i++)
+		{
+			if ((ret = k1b_tlb_inval(vaddr + (i << shift), shift, way)) < 0)
+				return (ret);
+		}
+
+		return (0);
+	}
+
+	coreid = k1b_core_get_id();
+
+	/* Invalidate by set. */
+	for (int i = 0; i < K1B_JTLB_LENGTH; i++)
+	{
+		tlbe = &tlb[coreid].jtlb[i];
+
+		if (tlbe->status == K1B_TLBE_STATUS_INVALID)
+			continue;
+
+		start = k1b_tlbe_vaddr_get(tlbe);
+		if (((start - vaddr) >> shift) >= npages)
+			continue;
+
+		ret = k1b_tlb_inval(
+			start,
+			__builtin_k1_ctz(k1b_tlbe_pgsize_get(tlbe)),
+			i % K1B_JTLB_WAYS
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * k1b_tlb_may_cache()                                                        *
+ *============================================================================*/
+
+/**
+ * The k1b_tlb_may_cache() function asserts if the JTLB of the core
+ * @p coreid may hold an entry for any of the @p npages pages starting
+ * at @p vaddr. The answer is conservative: it is based on the page
+ * table regions ever written into that JTLB.
+ */
+PUBLIC int k1b_tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages)
+{
+	uint32_t mask;
+	unsigned first;
+	unsigned last;
+
+	if (npages == 0)
+		return (0);
+
+	first = vaddr >> K1B_PGTAB_SHIFT;
+	last = (vaddr + (npages - 1)*K1B_PAGE_SIZE) >> K1B_PGTAB_SHIFT;
+
+	/* Range wraps around or spans all regions. */
+	if ((last < first) || ((last - first) >= 31))
+		mask = ~0u;
+	else
+	{
+		mask = 0;
+		for (unsigned i = first; i <= last; i++)
+			mask |= (1u << (i & 31));
+	}
+
+	return ((tlb[coreid].regions & mask) != 0);
+}
+
+/*============================================================================*
+ * k1b_tlb_asid_set()                                                         *
+ *============================================================================*/
+
+/**
+ * The k1b_tlb_asid_set() function sets the address space identifier
+ * of the underlying k1b core to @p asid. JTLB entries are written as
+ * global, thus hardware does not match them against the ASID. For
+ * this reason, entries that map user space are invalidated whenever
+ * the ASID changes, and kernel entries are kept.
+ */
+PUBLIC int k1b_tlb_asid_set(unsigned asid)
+{
+	int ret;
+	int coreid;
+	vaddr_t start;
+	const struct tlbe *tlbe;
+
+	/* Invalid ASID. */
+	if (asid >= (1u << K1B_TLB_ASID_BITS))
+		return (-EINVAL);
+
+	coreid = k1b_core_get_id();
+
+	/* Nothing to do. */
+	if (tlb[coreid].asid == asid)
+		return (0);
+
+	/* Drop entries of the previous address space. */
+	for (int i = 0; i < K1B_JTLB_LENGTH; i++)
+	{
+		tlbe = &tlb[coreid].jtlb[i];
+
+		if (tlbe->status == K1B_TLBE_STATUS_INVALID)
+			continue;
+
+		start = k1b_tlbe_vaddr_get(tlbe);
+		if ((start < K1B_USER_BASE_VIRT) || (start >= K1B_USER_END_VIRT))
+			continue;
+
+		ret = k1b_tlb_inval(
+			start,
+			__builtin_k1_ctz(k1b_tlbe_pgsize_get(tlbe)),
+			i % K1B_JTLB_WAYS
+		);
+
+		if (ret < 0)
+			return (ret);
+	}
+
+	tlb[coreid].asid = asid;
+
+	return (0);
+}
+
 /*============================================================================*
  * tlb_init()                                                                 *
  *============================================================================*/
@@ -340,10 +557,21 @@ PUBLIC void k1b_tlb_init(void)
 
 	kprintf("[core %d][hal] initializing tlb", coreid);
 
+	tlb[coreid].asid = 0;
+
 	/* Read JTLB into memory. */
+	tlb[coreid].regions = 0;
 	for (int i = 0; i < K1B_JTLB_LENGTH; i++)
+	{
 		k1b_tlbe_read(&tlb[coreid].jtlb[i], K1B_JTLB_OFFSET + i);
 
+		if (tlb[coreid].jtlb[i].status != K1B_TLBE_STATUS_INVALID)
+		{
+			tlb[coreid].regions |=
+				(1u << ((k1b_tlbe_vaddr_get(&tlb[coreid].jtlb[i]) >> K1B_PGTAB_SHIFT) & 31));
+		}
+	}
+
 	/* Read LTLB into memory. */
 	for (int i = 0; i < K1B_LTLB_LENGTH; i++)
 		k1b_tlbe_read(&tlb[coreid].ltlb[i], K1B_LTLB_OFFSET + i);
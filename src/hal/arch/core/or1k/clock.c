@@ -22,25 +22,91 @@
  * SOFTWARE.
  */
 
+#include <arch/cluster/or1k/cores.h>
 #include <nanvix/const.h>
 #include <nanvix/klib.h>
 #include <nanvix/hal/core/clock.h>
 #include <arch/core/or1k/core.h>
+#include <stdint.h>
+
+/**
+ * @brief Cycle counter.
+ *
+ * The tick timer runs freely and its 32-bit count is extended to 64
+ * bits in software, on a per-core basis.
+ */
+PRIVATE struct
+{
+	uint32_t high; /**< High-order bits of the counter. */
+	uint32_t last; /**< Last count read.                */
+} ALIGN(OR1K_CACHE_LINE_SIZE) or1k_clock_counter[OR1K_SMP_NUM_CORES];
+
+/**
+ * The or1k_clock_read_cycles() function reads the tick timer of the
+ * underlying or1k core and extends it to 64 bits. Interrupts are
+ * disabled while the counter is updated, so that the clock
+ * interrupt handler, which also updates it, does not race with us.
+ */
+PUBLIC uint64_t or1k_clock_read_cycles(void)
+{
+	unsigned sr;   /* Supervision Register. */
+	uint32_t now;  /* Current count.        */
+	uint64_t ret;  /* Cycle counter.        */
+	int coreid;    /* Core ID.              */
+
+	coreid = or1k_core_get_id();
+
+	sr = or1k_mfspr(OR1K_SPR_SR);
+	or1k_mtspr(OR1K_SPR_SR, sr & ~(OR1K_SPR_SR_IEE | OR1K_SPR_SR_TEE));
+
+		now = or1k_mfspr(OR1K_SPR_TTCR);
+
+		/* Count wrapped around. */
+		if (now < or1k_clock_counter[coreid].last)
+			or1k_clock_counter[coreid].high++;
+
+		or1k_clock_counter[coreid].last = now;
+
+		ret = (((uint64_t) or1k_clock_counter[coreid].high) << 32) | now;
+
+	or1k_mtspr(OR1K_SPR_SR, sr);
+
+	return (ret);
+}
 
 /**
  * ACKs the clock interrupt and adjusts the timer again.
  */
 PUBLIC void or1k_clock_ack(void)
 {
-	/* Ack. */
-	or1k_mtspr(OR1K_SPR_TTMR, OR1K_SPR_TTMR_DI);
+	unsigned next;
+
+	/* Ack and schedule next tick. */
+	next = (or1k_mfspr(OR1K_SPR_TTCR) + OR1K_CPU_FREQUENCY) & OR1K_SPR_TTMR_TP;
+	or1k_mtspr(OR1K_SPR_TTMR, OR1K_SPR_TTMR_CR | OR1K_SPR_TTMR_IE | next);
+
+	/* Account wraps of the counter. */
+	or1k_clock_read_cycles();
+}
+
+/**
+ * The or1k_clock_setup() function sets the tick timer of the
+ * underlying or1k core to run freely, with interrupts disabled. The
+ * count is never reset, so that it can be used as a cycle counter.
+ */
+PUBLIC void or1k_clock_setup(void)
+{
+	unsigned upr; /* Unit Present Register. */
 
-	/* Reenable timer. */
-	or1k_mtspr(OR1K_SPR_TTMR, OR1K_SPR_TTMR_SR | OR1K_SPR_TTMR_IE |
-		OR1K_CPU_FREQUENCY);
+	upr = or1k_mfspr(OR1K_SPR_UPR);
+	if ( !(upr & OR1K_SPR_UPR_TTP) )
+		while (1);
+
+	/* Already running. */
+	if (or1k_mfspr(OR1K_SPR_TTMR) & OR1K_SPR_TTMR_M)
+		return;
 
-	/* Reset counter. */
-	or1k_mtspr(OR1K_SPR_TTCR, 0);
+	or1k_mtspr(OR1K_SPR_TTMR, OR1K_SPR_TTMR_CR);
 }
 
 /**
@@ -50,19 +116,13 @@ PUBLIC void or1k_clock_ack(void)
  */
 PUBLIC void or1k_clock_init(unsigned freq)
 {
-	unsigned upr;  /* Unit Present Register. */
-	unsigned rate; /* Timer rate.            */
+	unsigned next; /* Next tick. */
 
 	UNUSED(freq);
 
-	upr = or1k_mfspr(OR1K_SPR_UPR);
-	if ( !(upr & OR1K_SPR_UPR_TTP) )
-		while (1);
-
-	/* Clock rate. */
-	rate = OR1K_CPU_FREQUENCY;
+	or1k_clock_setup();
 
-	/* Ensures that the clock is disabled. */
-	or1k_mtspr(OR1K_SPR_TTMR, OR1K_SPR_TTMR_SR | OR1K_SPR_TTMR_IE | rate);
-	or1k_mtspr(OR1K_SPR_TTCR, 0);
+	/* Schedule first tick. */
+	next = (or1k_mfspr(OR1K_SPR_TTCR) + OR1K_CPU_FREQUENCY) & OR1K_SPR_TTMR_TP;
+	or1k_mtspr(OR1K_SPR_TTMR, OR1K_SPR_TTMR_CR | OR1K_SPR_TTMR_IE | next);
 }
@@ -27,12 +27,15 @@
 #include <nanvix/const.h>
 #include <nanvix/klib.h>
 
-PUBLIC int pending_ipis[OR1K_SMP_NUM_CORES] = {0};
+/**
+ * @brief Pending IPIs.
+ */
+PUBLIC struct or1k_ipis pending_ipis[OR1K_SMP_NUM_CORES];
 
 /**
  * @brief Cores table.
  */
-PUBLIC struct coreinfo  ALIGN(OR1K_CACHE_LINE_SIZE) cores[OR1K_SMP_NUM_CORES] = {
+PUBLIC struct coreinfo cores[OR1K_SMP_NUM_CORES] = {
 	{ TRUE,  CORE_RUNNING,   0, NULL, OR1K_SPINLOCK_LOCKED }, /* Master Core   */
 	{ FALSE, CORE_RESETTING, 0, NULL, OR1K_SPINLOCK_LOCKED }, /* Slave Core 1  */
 };
@@ -48,29 +51,15 @@ PUBLIC struct coreinfo  ALIGN(OR1K_CACHE_LINE_SIZE) cores[OR1K_SMP_NUM_CORES] =
  */
 PUBLIC void or1k_core_waitclear(void)
 {
+	uint32_t ipis;
 	int mycoreid = or1k_core_get_id();
 
-	while (TRUE)
-	{
-		or1k_spinlock_lock(&cores[mycoreid].lock);
-
-			if (pending_ipis[mycoreid])
-				break;
-
-		or1k_spinlock_unlock(&cores[mycoreid].lock);
-	}
-
-		/* Clear IPI. */
-		for (int i = 0; i < OR1K_SMP_NUM_CORES; i++)
-		{
-			if (pending_ipis[mycoreid] & (1 << i))
-			{
-				pending_ipis[mycoreid] &= ~(1 << i);
-				break;
-			}
-		}
+	/* Wait for some IPI. */
+	while ((ipis = or1k_atomic_load(&pending_ipis[mycoreid].mask)) == 0)
+		/* noop */;
 
-	or1k_spinlock_unlock(&cores[mycoreid].lock);
+	/* Clear the IPI of the lowest-numbered sender. */
+	or1k_atomic_fetch_and(&pending_ipis[mycoreid].mask, ~(ipis & -ipis));
 }
 
 /*============================================================================*
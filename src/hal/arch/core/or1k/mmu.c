@@ -76,6 +76,11 @@ PUBLIC struct pte *kernel_pgtab = &or1k_kernel_pgtab[0];
  */
 PUBLIC struct pte *kpool_pgtab = &or1k_kpool_pgtab[0];
 
+/**
+ * Generation of page tables.
+ */
+PUBLIC volatile uint32_t or1k_pgtab_gen = 0;
+
 /**
  * @brief Handles a TLB fault.
  *
@@ -85,6 +90,11 @@ PUBLIC struct pte *kpool_pgtab = &or1k_kpool_pgtab[0];
  * the faulting address is not currently mapped in the current page
  * directory, it panics the kernel.
  *
+ * @note This is the slow path of TLB misses. Most of them are served
+ * by the refill fast path in hooks.S, which falls back here only for
+ * non-present pages, regions not yet published by this core, and
+ * stale translation storage buffers.
+ *
  * @param excp Exception information.
  * @param ctx  Interrupted execution context.
  *
@@ -105,6 +115,9 @@ PRIVATE void or1k_do_tlb_fault(
 
 	UNUSED(ctx);
 
+	/* Page tables may have changed. */
+	or1k_tlb_tsb_sync();
+
 	/* Get page address of faulting address. */
 	vaddr = or1k_excp_get_addr(excp);
 	vaddr &= OR1K_PAGE_MASK;
@@ -126,6 +139,9 @@ PRIVATE void or1k_do_tlb_fault(
 		OR1K_TLB_INSTRUCTION : OR1K_TLB_DATA;
 	if (or1k_tlb_write(tlb, vaddr, paddr) < 0)
 		kpanic("[hal] cannot write to tlb");
+
+	/* The faulting access retries as soon as we return. */
+	or1k_tlb_sync_entry(tlb, vaddr);
 }
 
 /**
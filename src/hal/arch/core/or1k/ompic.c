@@ -25,6 +25,7 @@
 #include <arch/core/or1k/core.h>
 #include <arch/core/or1k/ompic.h>
 #include <arch/cluster/or1k/memory.h>
+#include <nanvix/hal/core/tlb.h>
 #include <nanvix/const.h>
 #include <stdint.h>
 
@@ -66,6 +67,20 @@ PUBLIC void or1k_ompic_send_ipi(uint32_t dstcore, uint16_t data)
 		OR1K_OMPIC_CTRL_DST(dstcore)| OR1K_OMPIC_DATA(data));
 }
 
+/*
+ * @brief Sends a signal and an Inter-processor Interrupt.
+ *
+ * Unlike or1k_core_notify(), the target core is interrupted, thus it
+ * does not need to be waiting for the signal.
+ *
+ * @param coreid ID of the target core.
+ */
+PUBLIC void or1k_ompic_notify(int coreid)
+{
+	or1k_core_notify(coreid);
+	or1k_ompic_send_ipi(coreid, 0);
+}
+
 /*
  * @brief Handles to Inter-processor Interrupt here.
  *
@@ -82,6 +97,9 @@ PRIVATE void or1k_ompic_handle_ipi(int num)
 
 	/* ACK IPI. */
 	or1k_ompic_writereg(OR1K_OMPIC_CTRL(coreid), OR1K_OMPIC_CTRL_IRQ_ACK);
+
+	/* Serve TLB shootdowns. */
+	tlb_shootdown_handle();
 }
 
 /*
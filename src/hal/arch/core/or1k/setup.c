@@ -35,6 +35,9 @@ EXTERN NORETURN void kmain(int, const char *[]);
  */
 PUBLIC void or1k_core_setup(void)
 {
+	/* Start cycle counter. */
+	or1k_clock_setup();
+
 	/* Enable MMU. */
 	or1k_mmu_setup();
 
@@ -64,6 +67,9 @@ PUBLIC void or1k_core_setup(void)
  */
 PUBLIC NORETURN void or1k_slave_setup(void)
 {
+	/* Start cycle counter. */
+	or1k_clock_setup();
+
 	/* Initial TLB. */
 	or1k_tlb_init();
 
@@ -26,6 +26,29 @@
 #include <arch/cluster/or1k/memory.h>
 #include <nanvix/const.h>
 
+/**
+ * @brief Length of reverse map (number of buckets).
+ */
+#define OR1K_TLB_RMAP_LENGTH OR1K_TLB_LENGTH
+
+/**
+ * @brief Length of dirty bitmaps (number of words).
+ */
+#define OR1K_TLB_DIRTY_LENGTH ((OR1K_TLB_LENGTH + 31)/32)
+
+/**
+ * @brief Reverse Map
+ *
+ * Hashes physical page numbers into chains of TLB slots, so that
+ * lookups by physical address visit only the entries that may match.
+ * Links hold slot numbers plus one, so zero terminates a chain.
+ */
+struct tlb_rmap
+{
+	uint8_t head[OR1K_TLB_RMAP_LENGTH]; /**< First slot of each bucket. */
+	uint8_t next[OR1K_TLB_LENGTH];      /**< Next slot in the chain.    */
+};
+
 /**
  * @brief TLB
  *
@@ -44,7 +67,66 @@ PRIVATE struct
 	 * @brief Instruction TLB.
 	 */
 	struct tlbe itlb[OR1K_TLB_LENGTH];
-} tlb[OR1K_SMP_NUM_CORES];
+
+	/**
+	 * @brief Reverse map of Data TLB.
+	 */
+	struct tlb_rmap drmap;
+
+	/**
+	 * @brief Reverse map of Instruction TLB.
+	 */
+	struct tlb_rmap irmap;
+
+	/**
+	 * @brief Slots of Data TLB not yet written back to hardware.
+	 */
+	uint32_t ddirty[OR1K_TLB_DIRTY_LENGTH];
+
+	/**
+	 * @brief Slots of Instruction TLB not yet written back to hardware.
+	 */
+	uint32_t idirty[OR1K_TLB_DIRTY_LENGTH];
+
+	/**
+	 * @brief Current address space identifier.
+	 */
+	unsigned asid;
+} ALIGN(OR1K_CACHE_LINE_SIZE) tlb[OR1K_SMP_NUM_CORES];
+
+/**
+ * @brief Regions that may be cached, per core.
+ *
+ * Bit i is set once a page in a page table region congruent to i
+ * is written to the TLB, and is only cleared on initialization.
+ * Other cores read it to skip TLB shootdowns, and the TLB refill
+ * fast path in hooks.S reads it to know which regions it may fill
+ * on its own. Only the slow path, in C, sets bits.
+ */
+PUBLIC volatile uint32_t or1k_tlb_regions[OR1K_SMP_NUM_CORES];
+
+/**
+ * @brief Translation Storage Buffers
+ *
+ * Second-level TLB of each core, with one buffer for each TLB type,
+ * indexed by or1k_tsb_hash(). Entries hold xTLBMR and xTLBTR values
+ * ready to be written into hardware. They are looked up and filled by
+ * the refill fast path in hooks.S, and dropped in C.
+ */
+PUBLIC struct tlbe or1k_tsb[OR1K_SMP_NUM_CORES][2][OR1K_TSB_LENGTH] ALIGN(OR1K_CACHE_LINE_SIZE);
+
+/**
+ * @brief Statistics of Translation Storage Buffers
+ *
+ * Layout must match OR1K_TSB_STATS_*, since counters are updated in
+ * hooks.S.
+ */
+PUBLIC struct tsb_stats
+{
+	unsigned gen;    /**< Page table generation seen.  */
+	unsigned hits;   /**< Misses served by the buffer. */
+	unsigned misses; /**< Misses that walked.          */
+} ALIGN(OR1K_TSB_STATS_SIZE) or1k_tsb_stats[OR1K_SMP_NUM_CORES];
 
 /**
  * @brief TLB Entry Value
@@ -114,6 +196,223 @@ PRIVATE int or1k_tlb_check_inst(vaddr_t vaddr)
 	return (0);
 }
 
+/*============================================================================*
+ * or1k_tlb_hw_write()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Writes a TLB entry into the hardware TLB.
+ *
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param idx      Target slot.
+ * @param tlbe     Entry to write.
+ */
+PRIVATE void or1k_tlb_hw_write(int tlb_type, unsigned idx, const struct tlbe *tlbe)
+{
+	struct tlbe_value tlbev; /* TLB Entry value. */
+
+	tlbev.u.tlbe = *tlbe;
+
+	if (tlb_type == OR1K_TLB_INSTRUCTION)
+	{
+		or1k_mtspr(OR1K_SPR_ITLBTR_BASE(0) | idx, OR1K_TLBE_xTLBTR(tlbev.u.value));
+		or1k_mtspr(OR1K_SPR_ITLBMR_BASE(0) | idx, OR1K_TLBE_xTLBMR(tlbev.u.value));
+	}
+	else
+	{
+		or1k_mtspr(OR1K_SPR_DTLBTR_BASE(0) | idx, OR1K_TLBE_xTLBTR(tlbev.u.value));
+		or1k_mtspr(OR1K_SPR_DTLBMR_BASE(0) | idx, OR1K_TLBE_xTLBMR(tlbev.u.value));
+	}
+}
+
+/*============================================================================*
+ * or1k_tlb_writeback()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Writes back dirty slots of a TLB into hardware.
+ *
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param tlbe     Shadow entries of the target TLB.
+ * @param dirty    Dirty bitmap of the target TLB.
+ */
+PRIVATE void or1k_tlb_writeback(
+	int tlb_type,
+	const struct tlbe *tlbe,
+	uint32_t *dirty
+)
+{
+	for (unsigned i = 0; i < OR1K_TLB_DIRTY_LENGTH; i++)
+	{
+		uint32_t pending;
+
+		pending = dirty[i];
+		dirty[i] = 0;
+
+		/* Visit set bits only. */
+		while (pending != 0)
+		{
+			unsigned idx;
+
+			idx = (i << 5) + or1k_bit_ctz(pending);
+			pending &= pending - 1;
+
+			or1k_tlb_hw_write(tlb_type, idx, &tlbe[idx]);
+		}
+	}
+}
+
+/*============================================================================*
+ * or1k_tlb_rmap_hash()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Hashes a physical page number into a reverse map bucket.
+ *
+ * @param ppn Target physical page number.
+ *
+ * @returns The reverse map bucket of @p ppn.
+ */
+PRIVATE inline unsigned or1k_tlb_rmap_hash(unsigned ppn)
+{
+	return ((ppn ^ (ppn >> 6)) & (OR1K_TLB_RMAP_LENGTH - 1));
+}
+
+/*============================================================================*
+ * or1k_tlb_rmap_insert()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Inserts a TLB slot into a reverse map.
+ *
+ * @param rmap Target reverse map.
+ * @param tlbe Target TLB entries.
+ * @param idx  Slot to insert.
+ */
+PRIVATE void or1k_tlb_rmap_insert(
+	struct tlb_rmap *rmap,
+	const struct tlbe *tlbe,
+	unsigned idx
+)
+{
+	unsigned bucket;
+
+	bucket = or1k_tlb_rmap_hash(tlbe[idx].ppn);
+
+	rmap->next[idx] = rmap->head[bucket];
+	rmap->head[bucket] = idx + 1;
+}
+
+/*============================================================================*
+ * or1k_tlb_rmap_remove()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Removes a TLB slot from a reverse map.
+ *
+ * @param rmap Target reverse map.
+ * @param tlbe Target TLB entries.
+ * @param idx  Slot to remove.
+ *
+ * @note Invalid entries are not linked in the reverse map, thus
+ * nothing is done for them.
+ */
+PRIVATE void or1k_tlb_rmap_remove(
+	struct tlb_rmap *rmap,
+	const struct tlbe *tlbe,
+	unsigned idx
+)
+{
+	uint8_t *link;
+
+	if (tlbe[idx].valid != OR1K_TLBE_VALID)
+		return;
+
+	link = &rmap->head[or1k_tlb_rmap_hash(tlbe[idx].ppn)];
+
+	/* Unlink slot. */
+	while (*link != 0)
+	{
+		if (*link == (idx + 1))
+		{
+			*link = rmap->next[idx];
+			break;
+		}
+
+		link = &rmap->next[*link - 1];
+	}
+
+	rmap->next[idx] = 0;
+}
+
+/*============================================================================*
+ * or1k_tsb_hash()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Hashes a virtual page number into a translation storage
+ * buffer slot.
+ *
+ * @param vpn Target virtual page number.
+ *
+ * @returns The slot of @p vpn.
+ *
+ * @note Keep in sync with _tsb_entry in hooks.S.
+ */
+PRIVATE inline unsigned or1k_tsb_hash(unsigned vpn)
+{
+	return ((vpn ^ (vpn >> OR1K_TSB_SHIFT)) & (OR1K_TSB_LENGTH - 1));
+}
+
+/*============================================================================*
+ * or1k_tsb_inval_range()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Drops entries of a translation storage buffer.
+ *
+ * @param coreid   ID of the calling core.
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param vaddr    Start virtual address.
+ * @param npages   Number of pages.
+ *
+ * Entries are dropped by clearing their valid bit, in a single store,
+ * so that the refill fast path never sees a torn entry.
+ */
+PRIVATE void or1k_tsb_inval_range(int coreid, int tlb_type, vaddr_t vaddr, size_t npages)
+{
+	struct tlbe *tsb; /* Translation Storage Buffer. */
+	unsigned first;   /* First page.                 */
+
+	tsb = or1k_tsb[coreid][tlb_type];
+	first = vaddr >> PAGE_SHIFT;
+
+	/* Small range. */
+	if (npages < OR1K_TSB_LENGTH)
+	{
+		for (size_t i = 0; i < npages; i++)
+		{
+			vaddr_t page;
+			unsigned idx;
+
+			page = (vaddr & PAGE_MASK) + i*PAGE_SIZE;
+			idx = or1k_tsb_hash(page >> PAGE_SHIFT);
+
+			if (or1k_tlbe_vaddr_get(&tsb[idx]) == page)
+				tsb[idx].valid = !OR1K_TLBE_VALID;
+		}
+
+		return;
+	}
+
+	/* Invalidate by slot. */
+	for (unsigned i = 0; i < OR1K_TSB_LENGTH; i++)
+	{
+		if ((tsb[i].valid == OR1K_TLBE_VALID) && ((tsb[i].vpn - first) < npages))
+			tsb[i].valid = !OR1K_TLBE_VALID;
+	}
+}
+
 /*============================================================================*
  * or1k_tlb_lookup_vaddr()                                                    *
  *============================================================================*/
@@ -137,35 +436,25 @@ PUBLIC const struct tlbe *or1k_tlb_lookup_vaddr(int tlb_type, vaddr_t vaddr)
 {
 	const struct tlbe *tlbe; /* TLB Entry Pointer. */
 	vaddr_t addr;            /* Aligned address.   */
+	unsigned idx;            /* TLB Index.         */
 	int coreid;              /* Core ID.           */
 
 	addr = vaddr & PAGE_MASK;
+	idx = (vaddr >> PAGE_SHIFT) & (OR1K_TLB_LENGTH - 1);
 	coreid = or1k_core_get_id();
 
-	/* Search in ITLB. */
-	if (tlb_type == OR1K_TLB_INSTRUCTION)
-	{
-		for (int i = 0; i < OR1K_TLB_LENGTH; i++)
-		{
-			tlbe = &tlb[coreid].itlb[i];
-
-			/* Found. */
-			if (or1k_tlbe_vaddr_get(tlbe) == addr)
-				return (tlbe);
-		}
-	}
+	/*
+	 * The TLB is direct mapped, thus the only
+	 * entry that may encode vaddr is the one at idx.
+	 */
+	tlbe = (tlb_type == OR1K_TLB_INSTRUCTION) ?
+		&tlb[coreid].itlb[idx] : &tlb[coreid].dtlb[idx];
 
-	/* Search in DTLB. */
-	else
+	/* Found. */
+	if ((tlbe->valid == OR1K_TLBE_VALID) && (tlbe->cid == tlb[coreid].asid))
 	{
-		for (int i = 0; i < OR1K_TLB_LENGTH; i++)
-		{
-			tlbe = &tlb[coreid].dtlb[i];
-
-			/* Found. */
-			if (or1k_tlbe_vaddr_get(tlbe) == addr)
-				return (tlbe);
-		}
+		if (or1k_tlbe_vaddr_get(tlbe) == addr)
+			return (tlbe);
 	}
 
 	return (NULL);
@@ -192,79 +481,75 @@ PUBLIC const struct tlbe *or1k_tlb_lookup_vaddr(int tlb_type, vaddr_t vaddr)
  */
 PUBLIC const struct tlbe *or1k_tlb_lookup_paddr(int tlb_type, paddr_t paddr)
 {
-	const struct tlbe *tlbe;  /* TLB Entry Pointer. */
-	vaddr_t addr;             /* Aligned address.   */
-	int coreid;               /* Core ID.           */
+	const struct tlbe *tlbe;     /* TLB Entries.       */
+	const struct tlb_rmap *rmap; /* Reverse Map.       */
+	paddr_t addr;                /* Aligned address.   */
+	unsigned slot;               /* Slot plus one.     */
+	uint32_t irqs;               /* Interrupt state.   */
+	int coreid;                  /* Core ID.           */
 
 	addr = paddr & PAGE_MASK;
 	coreid = or1k_core_get_id();
 
-	/* Search in ITLB. */
 	if (tlb_type == OR1K_TLB_INSTRUCTION)
 	{
-		for (int i = 0; i < OR1K_TLB_LENGTH; i++)
-		{
-			tlbe = &tlb[coreid].itlb[i];
-
-			/* Found. */
-			if (or1k_tlbe_paddr_get(tlbe) == addr)
-				return (tlbe);
-		}
+		tlbe = tlb[coreid].itlb;
+		rmap = &tlb[coreid].irmap;
 	}
-
-	/* Search in DTLB. */
 	else
 	{
-		for (int i = 0; i < OR1K_TLB_LENGTH; i++)
-		{
-			tlbe = &tlb[coreid].dtlb[i];
+		tlbe = tlb[coreid].dtlb;
+		rmap = &tlb[coreid].drmap;
+	}
 
-			/* Found. */
-			if (or1k_tlbe_paddr_get(tlbe) == addr)
-				return (tlbe);
-		}
+	irqs = or1k_hwint_save();
+
+	/* Walk the chain of the target bucket. */
+	slot = rmap->head[or1k_tlb_rmap_hash(addr >> PAGE_SHIFT)];
+	while (slot != 0)
+	{
+		/* Found. */
+		if (or1k_tlbe_paddr_get(&tlbe[slot - 1]) == addr)
+			break;
+
+		slot = rmap->next[slot - 1];
 	}
 
-	return (NULL);
+	or1k_hwint_restore(irqs);
+
+	return ((slot != 0) ? &tlbe[slot - 1] : NULL);
 }
 
 /*============================================================================*
- * or1k_tlb_write()                                                           *
+ * or1k_tlb_write_slot()                                                      *
  *============================================================================*/
 
 /**
- * The or1k_tlb_write() function writes an entry into the architectural
- * TLB. If the new entry conflicts to an old one, the old one is
- * overwritten.
- *
- * @param tlb Handler number, identifies which TLB
- * type should be used.
- *
- * @param vaddr Virtual address to be mapped.
+ * @brief Writes an entry into the shadow TLB of a core.
  *
- * @param paddr Physical address to be mapped.
- *
- * @note Although the OpenRISC specification states that the TLB can
- * have up to 4-ways, there is no known implementation that uses more
- * than 1-way, i.e: direct mapping. Therefore, this function will use
- * only 1-way at the moment.
+ * @param coreid   ID of the calling core.
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param vaddr    Virtual address to be mapped.
+ * @param paddr    Physical address to be mapped.
  *
- * @author Davidson Francis
+ * The slot is marked dirty, and reaches hardware on the next flush.
+ * Interrupts must be disabled, since TLB shootdowns change the shadow
+ * TLB from interrupt context.
  */
-PUBLIC int or1k_tlb_write(int tlb_type, vaddr_t vaddr, paddr_t paddr)
+PRIVATE void or1k_tlb_write_slot(int coreid, int tlb_type, vaddr_t vaddr, paddr_t paddr)
 {
-	struct tlbe_value tlbev; /* TLB Entry value.   */
 	struct tlbe tlbe;        /* TLB Entry.         */
 	unsigned idx;            /* TLB Index.         */
 	unsigned user;           /* User address flag. */
 	unsigned inst;           /* Instruction flag.  */
 	volatile vaddr_t kcode;  /* Kernel start code. */
-	int coreid;              /* Core ID.           */
 
-	coreid = or1k_core_get_id();
 	kcode = (vaddr_t)&KSTART_CODE;
 	kmemset(&tlbe, 0, OR1K_TLBE_SIZE);
 
+	/* Publish region before the entry may be used. */
+	or1k_tlb_regions[coreid] |= (1u << ((vaddr >> OR1K_PGTAB_SHIFT) & 31));
+
 	user = 1;
 	/*
 	 * Check if the virtual address belongs to
@@ -344,7 +629,7 @@ PUBLIC int or1k_tlb_write(int tlb_type, vaddr_t vaddr, paddr_t paddr)
 	/* Remaining fields. */
 	tlbe.vpn = vaddr >> PAGE_SHIFT;
 	tlbe.lru = 0;
-	tlbe.cid = 0;
+	tlbe.cid = tlb[coreid].asid;
 	tlbe.pl = OR1K_TLBE_PL2;
 	tlbe.valid = OR1K_TLBE_VALID;
 
@@ -358,50 +643,49 @@ PUBLIC int or1k_tlb_write(int tlb_type, vaddr_t vaddr, paddr_t paddr)
 
 	/* TLB index. */
 	idx = (vaddr >> PAGE_SHIFT) & (OR1K_TLB_LENGTH - 1);
-	tlbev.u.tlbe = tlbe;
 
 	if (tlb_type == OR1K_TLB_INSTRUCTION)
 	{
 		/* Copy to the in-memory TLB copy. */
+		or1k_tlb_rmap_remove(&tlb[coreid].irmap, tlb[coreid].itlb, idx);
 		kmemcpy(&tlb[coreid].itlb[idx], &tlbe, OR1K_TLBE_SIZE);
+		or1k_tlb_rmap_insert(&tlb[coreid].irmap, tlb[coreid].itlb, idx);
 
-		/* Copy to HW TLB. */
-		or1k_mtspr(OR1K_SPR_ITLBTR_BASE(0) | idx, OR1K_TLBE_xTLBTR(tlbev.u.value));
-		or1k_mtspr(OR1K_SPR_ITLBMR_BASE(0) | idx, OR1K_TLBE_xTLBMR(tlbev.u.value));
+		/* Defer copy to HW TLB. */
+		tlb[coreid].idirty[idx >> 5] |= (1u << (idx & 31));
 	}
 	else
 	{
 		/* Copy to the in-memory TLB copy. */
+		or1k_tlb_rmap_remove(&tlb[coreid].drmap, tlb[coreid].dtlb, idx);
 		kmemcpy(&tlb[coreid].dtlb[idx], &tlbe, OR1K_TLBE_SIZE);
+		or1k_tlb_rmap_insert(&tlb[coreid].drmap, tlb[coreid].dtlb, idx);
 
-		/* Copy to HW TLB. */
-		or1k_mtspr(OR1K_SPR_DTLBTR_BASE(0) | idx, OR1K_TLBE_xTLBTR(tlbev.u.value));
-		or1k_mtspr(OR1K_SPR_DTLBMR_BASE(0) | idx, OR1K_TLBE_xTLBMR(tlbev.u.value));
+		/* Defer copy to HW TLB. */
+		tlb[coreid].ddirty[idx >> 5] |= (1u << (idx & 31));
 	}
-
-	return (0);
 }
 
+/*============================================================================*
+ * or1k_tlb_inval_slot()                                                      *
+ *============================================================================*/
+
 /**
- * The or1k_tlb_inval() function invalidates the TLB entry that
- * encodes the virtual address @p vaddr.
+ * @brief Invalidates a slot in the shadow TLB of a core.
  *
- * @param tlb Handler number, identifies which TLB
- * type should be used.
- *
- * @param vaddr Address to be invalidated.
+ * @param coreid   ID of the calling core.
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param idx      Target slot.
  *
- * @author Davidson Francis
+ * Unlike writes, invalidations reach hardware right away, so that
+ * no stale translation survives until the next flush. Interrupts must
+ * be disabled, as in or1k_tlb_write_slot().
  */
-PUBLIC int or1k_tlb_inval(int tlb_type, vaddr_t vaddr)
+PRIVATE void or1k_tlb_inval_slot(int coreid, int tlb_type, unsigned idx)
 {
 	struct tlbe_value tlbev; /* TLB Entry value. */
-	int idx;                 /* TLB Index.       */
-	int coreid;              /* Core ID.         */
 
-	idx = (vaddr >> PAGE_SHIFT) & (OR1K_TLB_LENGTH - 1);
 	tlbev.u.value = 0;
-	coreid = or1k_core_get_id();
 
 	/*
 	 * Invalidates the entry accordingly if
@@ -409,16 +693,271 @@ PUBLIC int or1k_tlb_inval(int tlb_type, vaddr_t vaddr)
 	 */
 	if (tlb_type == OR1K_TLB_INSTRUCTION)
 	{
+		or1k_tlb_rmap_remove(&tlb[coreid].irmap, tlb[coreid].itlb, idx);
 		kmemcpy(&tlb[coreid].itlb[idx], &tlbev.u.tlbe, OR1K_TLBE_SIZE);
+		tlb[coreid].idirty[idx >> 5] &= ~(1u << (idx & 31));
 		or1k_mtspr(OR1K_SPR_ITLBMR_BASE(0) | idx, 0);
 	}
 
 	/* Data. */
 	else
 	{
+		or1k_tlb_rmap_remove(&tlb[coreid].drmap, tlb[coreid].dtlb, idx);
 		kmemcpy(&tlb[coreid].dtlb[idx], &tlbev.u.tlbe, OR1K_TLBE_SIZE);
+		tlb[coreid].ddirty[idx >> 5] &= ~(1u << (idx & 31));
 		or1k_mtspr(OR1K_SPR_DTLBMR_BASE(0) | idx, 0);
 	}
+}
+
+/*============================================================================*
+ * or1k_tlb_write()                                                           *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_write() function writes an entry into the architectural
+ * TLB. If the new entry conflicts to an old one, the old one is
+ * overwritten.
+ *
+ * @param tlb Handler number, identifies which TLB
+ * type should be used.
+ *
+ * @param vaddr Virtual address to be mapped.
+ *
+ * @param paddr Physical address to be mapped.
+ *
+ * @note Although the OpenRISC specification states that the TLB can
+ * have up to 4-ways, there is no known implementation that uses more
+ * than 1-way, i.e: direct mapping. Therefore, this function will use
+ * only 1-way at the moment.
+ *
+ * @author Davidson Francis
+ */
+PUBLIC int or1k_tlb_write(int tlb_type, vaddr_t vaddr, paddr_t paddr)
+{
+	uint32_t irqs; /* Interrupt state. */
+
+	irqs = or1k_hwint_save();
+	or1k_tlb_write_slot(or1k_core_get_id(), tlb_type, vaddr, paddr);
+	or1k_hwint_restore(irqs);
+
+	return (0);
+}
+
+/*============================================================================*
+ * or1k_tlb_inval()                                                           *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_inval() function invalidates the TLB entry that
+ * encodes the virtual address @p vaddr, both in the shadow TLB and
+ * in hardware. The matching entry of the translation storage buffer,
+ * if any, is dropped as well.
+ *
+ * @param tlb Handler number, identifies which TLB
+ * type should be used.
+ *
+ * @param vaddr Address to be invalidated.
+ *
+ * @author Davidson Francis
+ */
+PUBLIC int or1k_tlb_inval(int tlb_type, vaddr_t vaddr)
+{
+	unsigned idx;  /* TLB Index.       */
+	uint32_t irqs; /* Interrupt state. */
+	int coreid;    /* Core ID.         */
+
+	idx = (vaddr >> PAGE_SHIFT) & (OR1K_TLB_LENGTH - 1);
+	coreid = or1k_core_get_id();
+
+	irqs = or1k_hwint_save();
+	or1k_tlb_inval_slot(coreid, tlb_type, idx);
+	or1k_tsb_inval_range(coreid, tlb_type, vaddr, 1);
+	or1k_hwint_restore(irqs);
+
+	return (0);
+}
+
+/*============================================================================*
+ * or1k_tlb_write_range()                                                     *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_write_range() function writes @p npages contiguous
+ * mappings, starting at @p vaddr and @p paddr, into the architectural
+ * TLB. Since the TLB is direct mapped, only the last
+ * @p OR1K_TLB_LENGTH pages of the range could survive, thus the
+ * pages before them are skipped.
+ *
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param vaddr    Start virtual address.
+ * @param paddr    Start physical address.
+ * @param npages   Number of pages.
+ *
+ * @returns This function always returns zero.
+ */
+PUBLIC int or1k_tlb_write_range(int tlb_type, vaddr_t vaddr, paddr_t paddr, size_t npages)
+{
+	size_t skip;   /* Pages skipped.   */
+	uint32_t irqs; /* Interrupt state. */
+	int coreid;    /* Core ID.         */
+
+	coreid = or1k_core_get_id();
+
+	skip = (npages > OR1K_TLB_LENGTH) ? npages - OR1K_TLB_LENGTH : 0;
+
+	irqs = or1k_hwint_save();
+	for (size_t i = skip; i < npages; i++)
+		or1k_tlb_write_slot(coreid, tlb_type, vaddr + i*PAGE_SIZE, paddr + i*PAGE_SIZE);
+	or1k_hwint_restore(irqs);
+
+	return (0);
+}
+
+/*============================================================================*
+ * or1k_tlb_inval_range()                                                     *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_inval_range() function invalidates the TLB entries
+ * that encode the @p npages pages starting at @p vaddr. If the range
+ * is larger than the TLB, each slot is visited once and invalidated
+ * if it falls in the range. Slots are checked both in the shadow TLB
+ * and in hardware, since the refill fast path in hooks.S fills the
+ * latter only.
+ *
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param vaddr    Start virtual address.
+ * @param npages   Number of pages.
+ *
+ * @returns This function always returns zero.
+ */
+PUBLIC int or1k_tlb_inval_range(int tlb_type, vaddr_t vaddr, size_t npages)
+{
+	const struct tlbe *tlbe; /* TLB Entries.     */
+	unsigned first;          /* First page.      */
+	unsigned mr;             /* xTLBMR.          */
+	uint32_t irqs;           /* Interrupt state. */
+	int coreid;              /* Core ID.         */
+
+	coreid = or1k_core_get_id();
+
+	irqs = or1k_hwint_save();
+
+	or1k_tsb_inval_range(coreid, tlb_type, vaddr, npages);
+
+	/* Small range. */
+	if (npages < OR1K_TLB_LENGTH)
+	{
+		for (size_t i = 0; i < npages; i++)
+		{
+			or1k_tlb_inval_slot(coreid, tlb_type,
+				((vaddr >> PAGE_SHIFT) + i) & (OR1K_TLB_LENGTH - 1)
+			);
+		}
+
+		or1k_hwint_restore(irqs);
+
+		return (0);
+	}
+
+	tlbe = (tlb_type == OR1K_TLB_INSTRUCTION) ?
+		tlb[coreid].itlb : tlb[coreid].dtlb;
+	first = vaddr >> PAGE_SHIFT;
+
+	/* Invalidate by set. */
+	for (unsigned i = 0; i < OR1K_TLB_LENGTH; i++)
+	{
+		mr = (tlb_type == OR1K_TLB_INSTRUCTION) ?
+			or1k_mfspr(OR1K_SPR_ITLBMR_BASE(0) | i) :
+			or1k_mfspr(OR1K_SPR_DTLBMR_BASE(0) | i);
+
+		/* Shadow entry in range. */
+		if ((tlbe[i].valid == OR1K_TLBE_VALID) && ((tlbe[i].vpn - first) < npages))
+			or1k_tlb_inval_slot(coreid, tlb_type, i);
+
+		/* Hardware entry in range. */
+		else if ((mr & OR1K_SPR_DTLBMR_V) && (((mr >> PAGE_SHIFT) - first) < npages))
+			or1k_tlb_inval_slot(coreid, tlb_type, i);
+	}
+
+	or1k_hwint_restore(irqs);
+
+	return (0);
+}
+
+/*============================================================================*
+ * or1k_tlb_may_cache()                                                       *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_may_cache() function asserts if the TLB of the core
+ * @p coreid may hold an entry for any of the @p npages pages starting
+ * at @p vaddr. The answer is conservative: it is based on the page
+ * table regions ever written into that TLB.
+ *
+ * @param coreid ID of the target core.
+ * @param vaddr  Start virtual address.
+ * @param npages Number of pages.
+ *
+ * @returns Zero if no entry encodes a page in the range, and non-zero
+ * if some entry may do so.
+ */
+PUBLIC int or1k_tlb_may_cache(int coreid, vaddr_t vaddr, size_t npages)
+{
+	uint32_t mask;  /* Regions in range. */
+	unsigned first; /* First region.     */
+	unsigned last;  /* Last region.      */
+
+	if (npages == 0)
+		return (0);
+
+	first = vaddr >> OR1K_PGTAB_SHIFT;
+	last = (vaddr + (npages - 1)*PAGE_SIZE) >> OR1K_PGTAB_SHIFT;
+
+	/* Range wraps around or spans all regions. */
+	if ((last < first) || ((last - first) >= 31))
+		mask = ~0u;
+	else
+	{
+		mask = 0;
+		for (unsigned i = first; i <= last; i++)
+			mask |= (1u << (i & 31));
+	}
+
+	return ((or1k_tlb_regions[coreid] & mask) != 0);
+}
+
+/*============================================================================*
+ * or1k_tlb_asid_set()                                                        *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_asid_set() function sets the address space identifier
+ * of the underlying or1k core to @p asid. Entries written afterwards
+ * are tagged with it, and only entries tagged with it are matched.
+ *
+ * @param asid Target address space identifier.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PUBLIC int or1k_tlb_asid_set(unsigned asid)
+{
+	unsigned sr;   /* Supervision Register. */
+	uint32_t irqs; /* Interrupt state.      */
+
+	/* Invalid ASID. */
+	if (asid >= (1u << OR1K_TLB_ASID_BITS))
+		return (-EINVAL);
+
+	irqs = or1k_hwint_save();
+
+	tlb[or1k_core_get_id()].asid = asid;
+
+	sr = or1k_mfspr(OR1K_SPR_SR) & ~OR1K_SPR_SR_CID;
+	or1k_mtspr(OR1K_SPR_SR, sr | (asid << 28));
+
+	or1k_hwint_restore(irqs);
 
 	return (0);
 }
@@ -431,30 +970,124 @@ PUBLIC int or1k_tlb_inval(int tlb_type, vaddr_t vaddr)
  * @brief Flushes changes in the TLB.
  *
  * The or1k_tlb_flush() function flushes the changes made to the
- * TLB of the underlying or1k core.
+ * TLB of the underlying or1k core. Only slots that were written or
+ * invalidated since the last flush are written back to hardware.
  *
  * @returns This function always returns zero.
  */
 PUBLIC int or1k_tlb_flush(void)
 {
-	struct tlbe_value tlbev; /* TLB Entry value. */
-	int coreid;              /* Core ID.         */
+	uint32_t irqs; /* Interrupt state. */
+	int coreid;    /* Core ID.         */
 
 	coreid = or1k_core_get_id();
 
-	for (int i = 0; i < OR1K_TLB_LENGTH; i++)
+	irqs = or1k_hwint_save();
+	or1k_tlb_writeback(OR1K_TLB_INSTRUCTION, tlb[coreid].itlb, tlb[coreid].idirty);
+	or1k_tlb_writeback(OR1K_TLB_DATA, tlb[coreid].dtlb, tlb[coreid].ddirty);
+	or1k_hwint_restore(irqs);
+
+	return (0);
+}
+
+/*============================================================================*
+ * or1k_tlb_sync_entry()                                                      *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_sync_entry() function writes back to hardware the
+ * TLB slot that encodes the virtual address @p vaddr, leaving other
+ * pending changes untouched.
+ *
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param vaddr    Target virtual address.
+ *
+ * @returns This function always returns zero.
+ */
+PUBLIC int or1k_tlb_sync_entry(int tlb_type, vaddr_t vaddr)
+{
+	unsigned idx;  /* TLB Index.       */
+	uint32_t irqs; /* Interrupt state. */
+	int coreid;    /* Core ID.         */
+
+	idx = (vaddr >> PAGE_SHIFT) & (OR1K_TLB_LENGTH - 1);
+	coreid = or1k_core_get_id();
+
+	irqs = or1k_hwint_save();
+
+	if (tlb_type == OR1K_TLB_INSTRUCTION)
+	{
+		tlb[coreid].idirty[idx >> 5] &= ~(1u << (idx & 31));
+		or1k_tlb_hw_write(tlb_type, idx, &tlb[coreid].itlb[idx]);
+	}
+	else
 	{
-		/* Data TLB. */
-		kmemcpy(&tlbev, &tlb[coreid].itlb[i], OR1K_TLBE_SIZE);
-		or1k_mtspr(OR1K_SPR_ITLBTR_BASE(0) | i, OR1K_TLBE_xTLBTR(tlbev.u.value));
-		or1k_mtspr(OR1K_SPR_ITLBMR_BASE(0) | i, OR1K_TLBE_xTLBMR(tlbev.u.value));
-
-		/* Instruction TLB. */
-		kmemcpy(&tlbev, &tlb[coreid].dtlb[i], OR1K_TLBE_SIZE);
-		or1k_mtspr(OR1K_SPR_DTLBTR_BASE(0) | i, OR1K_TLBE_xTLBTR(tlbev.u.value));
-		or1k_mtspr(OR1K_SPR_DTLBMR_BASE(0) | i, OR1K_TLBE_xTLBMR(tlbev.u.value));
+		tlb[coreid].ddirty[idx >> 5] &= ~(1u << (idx & 31));
+		or1k_tlb_hw_write(tlb_type, idx, &tlb[coreid].dtlb[idx]);
 	}
 
+	or1k_hwint_restore(irqs);
+
+	return (0);
+}
+
+/*============================================================================*
+ * or1k_tlb_tsb_sync()                                                        *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_tsb_sync() function drops all entries of the translation
+ * storage buffers of the calling core, if page tables have changed
+ * since they were last synchronized. Until then, the refill fast path
+ * in hooks.S does not use them.
+ */
+PUBLIC void or1k_tlb_tsb_sync(void)
+{
+	unsigned gen;  /* Page table generation. */
+	uint32_t irqs; /* Interrupt state.       */
+	int coreid;    /* Core ID.               */
+
+	coreid = or1k_core_get_id();
+	gen = or1k_pgtab_gen;
+
+	/* Nothing to do. */
+	if (or1k_tsb_stats[coreid].gen == gen)
+		return;
+
+	irqs = or1k_hwint_save();
+	kmemset(or1k_tsb[coreid], 0, sizeof(or1k_tsb[coreid]));
+	or1k_tsb_stats[coreid].gen = gen;
+	or1k_hwint_restore(irqs);
+}
+
+/*============================================================================*
+ * or1k_tlb_tsb_stats()                                                       *
+ *============================================================================*/
+
+/**
+ * The or1k_tlb_tsb_stats() function gets the number of TLB misses of
+ * the calling core that were served by its translation storage
+ * buffers (@p hits), and of those that were not (@p misses).
+ *
+ * @param hits   Store location for the number of hits.
+ * @param misses Store location for the number of misses.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PUBLIC int or1k_tlb_tsb_stats(unsigned *hits, unsigned *misses)
+{
+	int coreid; /* Core ID. */
+
+	/* Invalid store locations. */
+	if ((hits == NULL) || (misses == NULL))
+		return (-EINVAL);
+
+	coreid = or1k_core_get_id();
+
+	*hits = or1k_tsb_stats[coreid].hits;
+	*misses = or1k_tsb_stats[coreid].misses;
+
 	return (0);
 }
 
@@ -483,6 +1116,18 @@ PUBLIC void or1k_tlb_init(void)
 	if (!coreid)
 		kprintf("[hal] initializing tlb");
 
+	kmemset(&tlb[coreid].drmap, 0, sizeof(struct tlb_rmap));
+	kmemset(&tlb[coreid].irmap, 0, sizeof(struct tlb_rmap));
+	kmemset(tlb[coreid].ddirty, 0, sizeof(tlb[coreid].ddirty));
+	kmemset(tlb[coreid].idirty, 0, sizeof(tlb[coreid].idirty));
+	or1k_tlb_regions[coreid] = (1u << 0); /* Identity entries below. */
+	tlb[coreid].asid = 0;
+
+	kmemset(or1k_tsb[coreid], 0, sizeof(or1k_tsb[coreid]));
+	or1k_tsb_stats[coreid].gen = or1k_pgtab_gen;
+	or1k_tsb_stats[coreid].hits = 0;
+	or1k_tsb_stats[coreid].misses = 0;
+
 	/* Write into DTLB/ITLB. */
 	for (int i = 0; i < OR1K_TLB_LENGTH; i++)
 	{
@@ -497,6 +1142,9 @@ PUBLIC void or1k_tlb_init(void)
 		tlbev.u.value = ((uint64_t)xtlbmr << 32) | itlbtr;
 		kmemcpy(&tlb[coreid].itlb[i], &tlbev.u.tlbe, OR1K_TLBE_SIZE);
 
+		or1k_tlb_rmap_insert(&tlb[coreid].drmap, tlb[coreid].dtlb, i);
+		or1k_tlb_rmap_insert(&tlb[coreid].irmap, tlb[coreid].itlb, i);
+
 		dtlbtr += OR1K_PAGE_SIZE;
 		itlbtr += OR1K_PAGE_SIZE;
 		xtlbmr += OR1K_PAGE_SIZE;
@@ -61,7 +61,7 @@ PUBLIC int bostan_dnoc_rx_config(
         .counter_id = 0
 	};
 
-    k1b_dcache_inval();
+    k1b_dcache_inval_range(buffer, size);
 
     return mppa_noc_dnoc_rx_configure(interface, tag, config);
 }
@@ -122,7 +122,7 @@ PUBLIC void bostan_dnoc_tx_write(
     offset_config._.protocol = 0x1; //! absolute offset
     offset_config._.valid = 1;
 
-    k1b_dcache_inval();
+    k1b_dcache_flush_range(buffer, size);
 
     mppa_noc_dnoc_tx_set_push_offset(interface, tag, offset_config);
     mppa_noc_dnoc_tx_send_data(interface, tag, size, buffer);
@@ -180,7 +180,7 @@ PUBLIC int bostan_dnoc_uc_config_write(
     uc_config.channel_ids._.channel_6 = txtag;
     uc_config.channel_ids._.channel_7 = txtag;
 
-    k1b_dcache_inval();
+    k1b_dcache_flush_range(buffer, size);
 
     mppa_noc_dnoc_uc_set_linear_params(&uc_config, size, 0, 0);
 
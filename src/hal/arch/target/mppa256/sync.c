@@ -50,6 +50,18 @@ PRIVATE struct sync
 	} txs[MPPA256_SYNC_OPEN_MAX];
 } synctab;
 
+/**
+ * @brief Allocation bitmap of sender synchronization points.
+ *
+ * @note Receiver synchronization points are bound to fixed IDs, thus
+ * their pool is not backed by a bitmap.
+ */
+PRIVATE struct
+{
+	uint32_t hint;                                                  /**< Search hint. */
+	uint32_t bitmap[RESOURCE_BITMAP_LENGTH(MPPA256_SYNC_OPEN_MAX)]; /**< Bitmap.      */
+} txbitmap;
+
 /**
  * @brief Pools of Synchronization Resource
  */
@@ -58,8 +70,11 @@ PRIVATE struct syncpools
 	const struct resource_pool rx_pool;
 	const struct resource_pool tx_pool;
 } syncpools = {
-	.rx_pool = {synctab.rxs, MPPA256_SYNC_CREATE_MAX, sizeof(struct rx)},
-	.tx_pool = {synctab.txs, MPPA256_SYNC_OPEN_MAX,   sizeof(struct tx)},
+	.rx_pool = {synctab.rxs, MPPA256_SYNC_CREATE_MAX, sizeof(struct rx), NULL, NULL},
+	.tx_pool = {
+		synctab.txs, MPPA256_SYNC_OPEN_MAX, sizeof(struct tx),
+		txbitmap.bitmap, &txbitmap.hint
+	},
 };
 
 /**
@@ -279,7 +294,10 @@ PUBLIC int mppa256_sync_open(void)
 	interface = UNDERLYING_TX_INTERFACE(syncid);
 
 	if ((ret = bostan_dma_control_open(interface, tag)) < 0)
+	{
+		resource_free(&syncpools.tx_pool, syncid);
 		return (ret);
+	}
 
 	resource_set_used(&synctab.txs[syncid].resource);
 	resource_set_sync(&synctab.txs[syncid].resource);
@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/core/clock.h>
+#include <nanvix/const.h>
+#include <stdint.h>
+
+/**
+ * @brief Number of nanoseconds in one second.
+ */
+#define NSEC_PER_SEC 1000000000
+
+/**
+ * @brief Parameters for converting cycles to nanoseconds.
+ *
+ * A cycle count @e c is converted as (@e c * mult) >> shift.
+ */
+PRIVATE struct
+{
+	uint32_t mult;  /**< Multiplier. */
+	uint32_t shift; /**< Shift.      */
+} clock_conv = { 0, 0 };
+
+/**
+ * @brief Multiplies two 32-bit numbers.
+ *
+ * @param a  First operand.
+ * @param b  Second operand.
+ * @param hi Store location for the high-order word of the product.
+ * @param lo Store location for the low-order word of the product.
+ *
+ * @note Only 32-bit multiplications are used, so that we do not
+ * rely on compiler runtime support.
+ */
+PRIVATE inline void clock_mul32(uint32_t a, uint32_t b, uint32_t *hi, uint32_t *lo)
+{
+	uint32_t ll, lh, hl, hh, mid;
+
+	ll = (a & 0xffff)*(b & 0xffff);
+	lh = (a & 0xffff)*(b >> 16);
+	hl = (a >> 16)*(b & 0xffff);
+	hh = (a >> 16)*(b >> 16);
+
+	mid = (ll >> 16) + (lh & 0xffff) + (hl & 0xffff);
+
+	*lo = (mid << 16) | (ll & 0xffff);
+	*hi = hh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+}
+
+/**
+ * The clock_setup() function computes the multiplier and shift that
+ * convert cycles of the underlying core into nanoseconds. The largest
+ * shift for which the multiplier still fits in 32 bits is chosen, so
+ * that precision is maximized. Long division is carried out one bit
+ * at a time, thus no 64-bit arithmetic is required.
+ */
+PUBLIC void clock_setup(void)
+{
+	uint32_t freq;  /* Frequency of cycle counter. */
+	uint32_t q;     /* Quotient.                   */
+	uint32_t r;     /* Remainder.                  */
+	uint32_t s;     /* Shift.                      */
+
+	freq = clock_cycles_freq();
+
+	/* Bad frequency. */
+	if (freq == 0)
+		return;
+
+	q = NSEC_PER_SEC/freq;
+	r = NSEC_PER_SEC%freq;
+
+	for (s = 0; (s < 32) && !(q & 0x80000000); s++)
+	{
+		q <<= 1;
+
+		/* 2r >= freq, without overflowing. */
+		if (r >= freq - r)
+		{
+			r -= freq - r;
+			q |= 1;
+		}
+		else
+			r <<= 1;
+	}
+
+	clock_conv.mult = q;
+	clock_conv.shift = s;
+}
+
+/**
+ * The clock_read_ns() function reads the cycle counter of the
+ * underlying core and converts it to nanoseconds. The 96-bit
+ * intermediate product is computed with 32-bit multiplications.
+ */
+PUBLIC uint64_t clock_read_ns(void)
+{
+	uint64_t cycles;         /* Cycle counter.    */
+	uint32_t h0, l0, h1, l1; /* Partial products. */
+	uint32_t w0, w1, w2;     /* Full product.     */
+	uint32_t s;              /* Shift.            */
+
+	cycles = clock_read_cycles();
+
+	clock_mul32((uint32_t) cycles, clock_conv.mult, &h0, &l0);
+	clock_mul32((uint32_t)(cycles >> 32), clock_conv.mult, &h1, &l1);
+
+	w0 = l0;
+	w1 = h0 + l1;
+	w2 = h1 + ((w1 < h0) ? 1 : 0);
+
+	s = clock_conv.shift;
+
+	if (s == 0)
+		return ((((uint64_t) w1) << 32) | w0);
+	if (s == 32)
+		return ((((uint64_t) w2) << 32) | w1);
+
+	return (
+		(((uint64_t) ((w1 >> s) | (w2 << (32 - s)))) << 32) |
+		((w0 >> s) | (w1 << (32 - s)))
+	);
+}
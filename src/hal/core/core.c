@@ -24,6 +24,7 @@
 
 #define __NEED_HAL_CLUSTER
 #include <nanvix/hal/cluster.h>
+#include <nanvix/hal/log.h>
 #include <nanvix/const.h>
 #include <nanvix/klib.h>
 
@@ -53,13 +54,11 @@ PUBLIC void core_idle(void)
 		 * core_reset().
 		 */
 
-	dcache_invalidate();
 	spinlock_unlock(&cores[coreid].lock);
 
 	while (TRUE)
 	{
 		spinlock_lock(&cores[coreid].lock);
-		dcache_invalidate();
 
 			/* Awaken. */
 			if (cores[coreid].state != CORE_IDLE)
@@ -70,9 +69,16 @@ PUBLIC void core_idle(void)
 
 			core_clear();
 
-		dcache_invalidate();
 		spinlock_unlock(&cores[coreid].lock);
 
+		/*
+		 * Serve shootdowns whose signal was
+		 * just cleared, otherwise their
+		 * posters would wait forever.
+		 */
+		tlb_shootdown_handle();
+
+		hal_log_drain();
 		core_waitclear();
 	}
 }
@@ -93,31 +99,40 @@ PUBLIC void core_idle(void)
  */
 PUBLIC void core_sleep(void)
 {
+	uint32_t wakeups;
 	int coreid = core_get_id();
 
 	while (TRUE)
 	{
-		spinlock_lock(&cores[coreid].lock);
-		dcache_invalidate();
+		/*
+		 * Clear pending signals before checking for
+		 * wakeups, otherwise a signal sent in between
+		 * would be lost and we would sleep forever.
+		 */
+		core_clear();
+		hal_mb();
 
-			/* Awaken. */
-			if (cores[coreid].wakeups > 0)
-			{
-				cores[coreid].wakeups--;
-				cores[coreid].state = CORE_RUNNING;
+		/* Serve shootdowns whose signal was just cleared. */
+		tlb_shootdown_handle();
 
-				dcache_invalidate();
-				spinlock_unlock(&cores[coreid].lock);
+		/* Awaken. */
+		while ((wakeups = atomic_load(&cores[coreid].wakeups)) > 0)
+		{
+			if (atomic_cas(&cores[coreid].wakeups, wakeups, wakeups - 1) != wakeups)
+				continue;
 
-				break;
-			}
+			spinlock_lock(&cores[coreid].lock);
+				cores[coreid].state = CORE_RUNNING;
+			spinlock_unlock(&cores[coreid].lock);
 
-			cores[coreid].state = CORE_SLEEPING;
-			core_clear();
+			return;
+		}
 
-		dcache_invalidate();
+		spinlock_lock(&cores[coreid].lock);
+			cores[coreid].state = CORE_SLEEPING;
 		spinlock_unlock(&cores[coreid].lock);
 
+		hal_log_drain();
 		core_waitclear();
 	}
 }
@@ -138,15 +153,10 @@ PUBLIC void core_sleep(void)
  */
 PUBLIC void core_wakeup(int coreid)
 {
-	spinlock_lock(&cores[coreid].lock);
-	dcache_invalidate();
-
-		/* Wakeup target core. */
-		cores[coreid].wakeups++;
-		core_notify(coreid);
-
-	dcache_invalidate();
-	spinlock_unlock(&cores[coreid].lock);
+	/* Wakeup target core. */
+	atomic_fetch_add(&cores[coreid].wakeups, 1);
+	hal_wmb();
+	core_notify(coreid);
 }
 
 /*============================================================================*
@@ -169,7 +179,6 @@ PUBLIC void core_start(int coreid, void (*start)(void))
 again:
 
 	spinlock_lock(&cores[coreid].lock);
-	dcache_invalidate();
 
 	/* Wait for reset. */
 	if (cores[coreid].state == CORE_RESETTING)
@@ -183,8 +192,8 @@ again:
 	{
 		cores[coreid].state = CORE_RUNNING;
 		cores[coreid].start = start;
-		cores[coreid].wakeups = 0;
-		dcache_invalidate();
+		atomic_store(&cores[coreid].wakeups, 0);
+		hal_wmb();
 
 		core_notify(coreid);
 	}
@@ -212,14 +221,12 @@ PUBLIC void core_run(void)
 	int coreid = core_get_id();
 
 	spinlock_lock(&cores[coreid].lock);
-	dcache_invalidate();
 
 		/* Initialize core. */
 		if (!cores[coreid].initialized)
 		{
 			core_setup();
 			cores[coreid].initialized = TRUE;
-			dcache_invalidate();
 		}
 
 	spinlock_unlock(&cores[coreid].lock);
@@ -247,11 +254,10 @@ PUBLIC void core_reset(void)
 	int coreid = core_get_id();
 
 	spinlock_lock(&cores[coreid].lock);
-	dcache_invalidate();
 
 		cores[coreid].state = CORE_RESETTING;
 
-		dcache_invalidate();
+		hal_wmb();
 
 		_core_reset();
 
@@ -284,8 +290,10 @@ PUBLIC void core_shutdown(int status)
 
 		cores[coreid].state = CORE_OFFLINE;
 
-	dcache_invalidate();
 	spinlock_unlock(&cores[coreid].lock);
 
+	/* Do not lose pending log messages. */
+	hal_log_drain();
+
 	core_poweroff();
 }
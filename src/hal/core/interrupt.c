@@ -64,10 +64,10 @@ PUBLIC int interrupt_register(int num, interrupt_handler_t handler)
 		return (-EBUSY);
 
 	interrupts[num].handled = TRUE;
-	dcache_invalidate();
+	dcache_flush_range(&interrupts[num], sizeof(interrupts[num]));
 	interrupt_set_handler(num, handler);
 
-	kprintf("[hal] interrupt handler registered for irq %d", num);
+	klog("[hal] interrupt handler registered for irq %d", num);
 
 	return (0);
 }
@@ -89,10 +89,10 @@ PUBLIC int interrupt_unregister(int num)
 		return (-EINVAL);
 
 	interrupts[num].handled = FALSE;
-	dcache_invalidate();
+	dcache_flush_range(&interrupts[num], sizeof(interrupts[num]));
 	interrupt_set_handler(num, default_handler);
 
-	kprintf("[hal] interrupt handler unregistered for irq %d", num);
+	klog("[hal] interrupt handler unregistered for irq %d", num);
 
 	return (0);
 }
@@ -106,7 +106,7 @@ PUBLIC void interrupt_setup(void)
 	for (int i = 0; i < INTERRUPTS_NUM; i++)
 	{
 		interrupts[i].handled = FALSE;
-		dcache_invalidate();
+		dcache_flush_range(&interrupts[i], sizeof(interrupts[i]));
 		interrupt_set_handler(i, default_handler);
 	}
 
@@ -0,0 +1,282 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/klib.h>
+#include <stdint.h>
+
+#if defined(HAL_LOCKSTAT)
+
+/**
+ * @brief Statistics of a lock site.
+ */
+struct lockstat_site
+{
+	const char *file;      /**< Source file.                */
+	int line;              /**< Source line.                */
+	unsigned acquisitions; /**< Number of acquisitions.     */
+	unsigned contended;    /**< Contended acquisitions.     */
+	uint64_t spin_total;   /**< Cycles spent spinning.      */
+	uint32_t spin_max;     /**< Longest spin (in cycles).   */
+	uint64_t hold_total;   /**< Cycles the lock was held.   */
+	uint32_t hold_max;     /**< Longest hold (in cycles).   */
+};
+
+/**
+ * @brief Lock held by a core.
+ */
+struct lockstat_held
+{
+	spinlock_t *lock;           /**< Lock.                */
+	struct lockstat_site *site; /**< Acquisition site.    */
+	uint64_t since;             /**< Acquisition time.    */
+};
+
+/**
+ * @brief Lock statistics.
+ *
+ * Each core updates only its own entry, so that no locking is needed.
+ */
+PRIVATE struct
+{
+	struct lockstat_site sites[LOCKSTAT_SITES_MAX]; /**< Lock sites.   */
+	struct lockstat_held held[LOCKSTAT_DEPTH_MAX];  /**< Locks held.   */
+	int nheld;                                      /**< Locks held.   */
+	int overflows;                                  /**< Sites missed. */
+} ALIGN(CACHE_LINE_SIZE) lockstat[CORES_NUM];
+
+/**
+ * @brief Gets the statistics of a lock site.
+ *
+ * @param coreid ID of the calling core.
+ * @param file   Source file of the call site.
+ * @param line   Source line of the call site.
+ *
+ * @returns Upon successful completion, the statistics of the target
+ * lock site are returned. If there is no room for it, NULL is
+ * returned instead.
+ */
+PRIVATE struct lockstat_site *lockstat_site_get(int coreid, const char *file, int line)
+{
+	unsigned h;
+
+	h = (((unsigned) file) ^ ((unsigned) line*2654435761u)) % LOCKSTAT_SITES_MAX;
+
+	for (int i = 0; i < LOCKSTAT_SITES_MAX; i++)
+	{
+		struct lockstat_site *site;
+
+		site = &lockstat[coreid].sites[(h + i) % LOCKSTAT_SITES_MAX];
+
+		/* Found. */
+		if ((site->file == file) && (site->line == line))
+			return (site);
+
+		/* Free slot. */
+		if (site->file == NULL)
+		{
+			site->file = file;
+			site->line = line;
+			return (site);
+		}
+	}
+
+	lockstat[coreid].overflows++;
+
+	return (NULL);
+}
+
+/**
+ * @brief Records a lock acquisition.
+ *
+ * @param lock      Target spinlock.
+ * @param file      Source file of the call site.
+ * @param line      Source line of the call site.
+ * @param contended Was the lock contended?
+ * @param t0        Time before spinning.
+ * @param t1        Time after spinning.
+ */
+PRIVATE void lockstat_acquired(
+	spinlock_t *lock,
+	const char *file,
+	int line,
+	int contended,
+	uint64_t t0,
+	uint64_t t1
+)
+{
+	int coreid;
+	uint32_t spin;
+	struct lockstat_site *site;
+
+	coreid = core_get_id();
+
+	if ((site = lockstat_site_get(coreid, file, line)) == NULL)
+		return;
+
+	spin = (uint32_t)(t1 - t0);
+
+	site->acquisitions++;
+	if (contended)
+		site->contended++;
+	site->spin_total += spin;
+	if (spin > site->spin_max)
+		site->spin_max = spin;
+
+	/* Track hold time. */
+	if (lockstat[coreid].nheld < LOCKSTAT_DEPTH_MAX)
+	{
+		struct lockstat_held *held;
+
+		held = &lockstat[coreid].held[lockstat[coreid].nheld++];
+		held->lock = lock;
+		held->site = site;
+		held->since = t1;
+	}
+}
+
+/**
+ * The lockstat_spinlock_lock() function locks the spinlock pointed
+ * to by @p lock and records, for the call site given by @p file and
+ * @p line, the number of cycles spent spinning. The lock is deemed
+ * contended if it was locked right before the call.
+ */
+PUBLIC void lockstat_spinlock_lock(spinlock_t *lock, const char *file, int line)
+{
+	int contended;
+	uint64_t t0, t1;
+
+	contended = (*((volatile spinlock_t *) lock) != SPINLOCK_UNLOCKED);
+
+	t0 = clock_read_cycles();
+	(spinlock_lock)(lock);
+	t1 = clock_read_cycles();
+
+	lockstat_acquired(lock, file, line, contended, t0, t1);
+}
+
+/**
+ * The lockstat_spinlock_trylock() function attempts to lock the
+ * spinlock pointed to by @p lock, and records statistics for the call
+ * site given by @p file and @p line, if it succeeds. A failed attempt
+ * is accounted as a contended acquisition with no spinning.
+ */
+PUBLIC int lockstat_spinlock_trylock(spinlock_t *lock, const char *file, int line)
+{
+	int ret;
+	uint64_t t0;
+
+	t0 = clock_read_cycles();
+	ret = (spinlock_trylock)(lock);
+
+	if (SPINLOCK_TRYLOCK_OK(ret))
+		lockstat_acquired(lock, file, line, 0, t0, t0);
+	else
+	{
+		struct lockstat_site *site;
+
+		if ((site = lockstat_site_get(core_get_id(), file, line)) != NULL)
+			site->contended++;
+	}
+
+	return (ret);
+}
+
+/**
+ * The lockstat_spinlock_unlock() function unlocks the spinlock pointed
+ * to by @p lock and records for how long it was held. Locks released by
+ * a core other than the one that acquired them are not accounted.
+ */
+PUBLIC void lockstat_spinlock_unlock(spinlock_t *lock)
+{
+	int coreid;
+	uint64_t t;
+
+	coreid = core_get_id();
+	t = clock_read_cycles();
+
+	for (int i = lockstat[coreid].nheld - 1; i >= 0; i--)
+	{
+		uint32_t hold;
+		struct lockstat_held *held;
+
+		held = &lockstat[coreid].held[i];
+
+		if (held->lock != lock)
+			continue;
+
+		hold = (uint32_t)(t - held->since);
+		held->site->hold_total += hold;
+		if (hold > held->site->hold_max)
+			held->site->hold_max = hold;
+
+		/* Remove entry. */
+		for (int j = i; j < lockstat[coreid].nheld - 1; j++)
+			lockstat[coreid].held[j] = lockstat[coreid].held[j + 1];
+		lockstat[coreid].nheld--;
+
+		break;
+	}
+
+	(spinlock_unlock)(lock);
+}
+
+/**
+ * The lockstat_dump() function prints the statistics of all lock
+ * sites, one line per core and site. Cycle totals are given in
+ * units of 1024 cycles.
+ */
+PUBLIC void lockstat_dump(void)
+{
+	for (int coreid = 0; coreid < CORES_NUM; coreid++)
+	{
+		for (int i = 0; i < LOCKSTAT_SITES_MAX; i++)
+		{
+			struct lockstat_site site;
+
+			site = lockstat[coreid].sites[i];
+
+			if (site.file == NULL)
+				continue;
+
+			kprintf("[lockstat] core %d %s:%d acq %u cont %u spin %u/%uk hold %u/%uk",
+				coreid,
+				site.file,
+				site.line,
+				site.acquisitions,
+				site.contended,
+				site.spin_max,
+				(unsigned)(site.spin_total >> 10),
+				site.hold_max,
+				(unsigned)(site.hold_total >> 10)
+			);
+		}
+
+		if (lockstat[coreid].overflows > 0)
+			kprintf("[lockstat] core %d %d sites missed", coreid, lockstat[coreid].overflows);
+	}
+}
+
+#endif /* HAL_LOCKSTAT */
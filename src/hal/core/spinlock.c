@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/klib.h>
+#include <stdint.h>
+
+#if !defined(__qspinlock_t)
+
+/**
+ * @brief Queue nodes of MCS spinlocks.
+ */
+PRIVATE struct qspinlock_node qspinlock_nodes[CORES_NUM][QSPINLOCK_NESTING];
+
+/**
+ * @brief Allocates a queue node for the underlying core.
+ *
+ * @returns A free queue node of the underlying core.
+ *
+ * @note An interrupt handler that takes a queue spinlock releases it
+ * before returning, thus no further synchronization is required.
+ */
+PRIVATE struct qspinlock_node *qspinlock_node_alloc(void)
+{
+	int coreid = core_get_id();
+
+	for (int i = 0; i < QSPINLOCK_NESTING; i++)
+	{
+		struct qspinlock_node *node = &qspinlock_nodes[coreid][i];
+
+		if (!node->busy)
+		{
+			node->busy = 1;
+			node->next = NULL;
+			node->locked = 1;
+
+			return (node);
+		}
+	}
+
+	kpanic("[hal] too many queue spinlocks held");
+
+	return (NULL);
+}
+
+/**
+ * @brief Releases a queue node.
+ *
+ * @param node Target queue node.
+ */
+PRIVATE inline void qspinlock_node_free(struct qspinlock_node *node)
+{
+	node->busy = 0;
+}
+
+/*============================================================================*
+ * qspinlock_trylock()                                                        *
+ *============================================================================*/
+
+/**
+ * The qspinlock_trylock() function attempts to lock the queue spinlock
+ * pointed to by @p lock. The lock is taken only if no other core holds
+ * it or waits for it.
+ */
+PUBLIC int qspinlock_trylock(qspinlock_t *lock)
+{
+	struct qspinlock_node *node;
+
+	/* Lock is busy. */
+	if (atomic_load(&lock->tail) != 0)
+		return (1);
+
+	node = qspinlock_node_alloc();
+
+	if (atomic_cas(&lock->tail, 0, (uint32_t) node) != 0)
+	{
+		qspinlock_node_free(node);
+		return (1);
+	}
+
+	hal_acquire();
+	lock->owner = node;
+
+	return (0);
+}
+
+/*============================================================================*
+ * qspinlock_lock()                                                           *
+ *============================================================================*/
+
+/**
+ * The qspinlock_lock() function locks the queue spinlock pointed to by
+ * @p lock. The calling core enqueues one of its nodes at the tail of
+ * the lock and spins on that node, until its predecessor hands the
+ * lock over.
+ */
+PUBLIC void qspinlock_lock(qspinlock_t *lock)
+{
+	struct qspinlock_node *node;
+	struct qspinlock_node *pred;
+
+	node = qspinlock_node_alloc();
+
+	pred = (struct qspinlock_node *) atomic_xchg(&lock->tail, (uint32_t) node);
+
+	/* Wait for our turn. */
+	if (pred != NULL)
+	{
+		pred->next = node;
+
+		while (atomic_load(&node->locked))
+			/* noop */;
+	}
+
+	hal_acquire();
+	lock->owner = node;
+}
+
+/*============================================================================*
+ * qspinlock_unlock()                                                         *
+ *============================================================================*/
+
+/**
+ * The qspinlock_unlock() function unlocks the queue spinlock pointed
+ * to by @p lock, handing it over to the next waiter, if any.
+ */
+PUBLIC void qspinlock_unlock(qspinlock_t *lock)
+{
+	struct qspinlock_node *node;
+
+	node = lock->owner;
+
+	hal_release();
+
+	if (node->next == NULL)
+	{
+		/* No waiters. */
+		if (atomic_cas(&lock->tail, (uint32_t) node, 0) == (uint32_t) node)
+		{
+			qspinlock_node_free(node);
+			return;
+		}
+
+		/* Wait for successor to link itself. */
+		while (node->next == NULL)
+			/* noop */;
+	}
+
+	atomic_store(&node->next->locked, 0);
+	qspinlock_node_free(node);
+}
+
+#endif /* !__qspinlock_t */
@@ -0,0 +1,659 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/klib.h>
+#include <errno.h>
+
+#if (CORES_NUM > TLB_SHOOTDOWN_CORES_MAX)
+#error "too many cores for TLB shootdown"
+#endif
+
+#ifndef __tlb_notify_fn
+
+/**
+ * @brief Notifies a core of pending TLB shootdowns.
+ *
+ * @param coreid ID of the target core.
+ */
+PRIVATE inline void tlb_shootdown_notify(int coreid)
+{
+	core_notify(coreid);
+}
+
+/**
+ * @brief Masks shootdown notifications in the calling core.
+ *
+ * Shootdowns are not served in interrupt context, thus there is
+ * nothing to mask.
+ */
+PRIVATE inline unsigned tlb_shootdown_irq_save(void)
+{
+	return (0);
+}
+
+/**
+ * @brief Unmasks shootdown notifications in the calling core.
+ */
+PRIVATE inline void tlb_shootdown_irq_restore(unsigned state)
+{
+	UNUSED(state);
+}
+
+#endif
+
+/**
+ * @brief TLB shootdown mailboxes.
+ *
+ * Each core drains its own mailbox, while any core may post requests
+ * into it. A single IPI is raised for all requests posted before the
+ * target core handles them. Mailboxes are locked with shootdown
+ * IPIs masked, otherwise a handler could spin on a lock held by the
+ * code that it interrupted.
+ */
+PRIVATE struct
+{
+	spinlock_t lock;            /**< Lock.                           */
+	int nreqs;                  /**< Number of pending requests.     */
+	int overflow;               /**< Invalidate the whole TLB?       */
+	int notified;               /**< IPI raised and not yet handled? */
+	volatile uint32_t posted;   /**< Ticket of last request posted.  */
+	volatile uint32_t acked;    /**< Ticket of last request handled. */
+
+	/**
+	 * @brief Pending requests.
+	 */
+	struct
+	{
+		vaddr_t vaddr; /**< Start virtual address. */
+		size_t npages; /**< Number of pages.       */
+	} reqs[TLB_SHOOTDOWN_LENGTH];
+} ALIGN(CACHE_LINE_SIZE) mailboxes[CORES_NUM];
+
+/*============================================================================*
+ * tlb_batch_add()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Adds an operation to a TLB batch.
+ *
+ * @param batch    Target batch.
+ * @param op       Operation.
+ * @param tlb_type Target TLB (D-TLB or I-TLB).
+ * @param vaddr    Start virtual address.
+ * @param paddr    Start physical address.
+ * @param npages   Number of pages.
+ *
+ * The operation is merged into the last one, if they are of the same
+ * kind and their ranges are contiguous. If the batch is full, it is
+ * committed before the operation is added.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE int tlb_batch_add(
+	struct tlb_batch *batch,
+	int op,
+	int tlb_type,
+	vaddr_t vaddr,
+	paddr_t paddr,
+	size_t npages
+)
+{
+	int ret;
+	int last;
+
+	/* Invalid batch. */
+	if (batch == NULL)
+		return (-EINVAL);
+
+	/* Invalid TLB type. */
+	if ((tlb_type != TLB_INSTRUCTION) && (tlb_type != TLB_DATA))
+		return (-EINVAL);
+
+	/* Nothing to do. */
+	if (npages == 0)
+		return (0);
+
+	/* Merge with last operation. */
+	if ((last = batch->nops - 1) >= 0)
+	{
+		if ((batch->ops[last].op == op) &&
+			(batch->ops[last].tlb_type == tlb_type) &&
+			(batch->ops[last].vaddr + batch->ops[last].npages*PAGE_SIZE == vaddr) &&
+			((op == TLB_BATCH_INVAL) ||
+			 (batch->ops[last].paddr + batch->ops[last].npages*PAGE_SIZE == paddr)))
+		{
+			batch->ops[last].npages += npages;
+			return (0);
+		}
+	}
+
+	/* Batch is full. */
+	if (batch->nops == TLB_BATCH_LENGTH)
+	{
+		if ((ret = tlb_batch_commit(batch)) < 0)
+			return (ret);
+	}
+
+	batch->ops[batch->nops].op = op;
+	batch->ops[batch->nops].tlb_type = tlb_type;
+	batch->ops[batch->nops].vaddr = vaddr;
+	batch->ops[batch->nops].paddr = paddr;
+	batch->ops[batch->nops].npages = npages;
+	batch->nops++;
+
+	return (0);
+}
+
+/*============================================================================*
+ * tlb_batch_init()                                                           *
+ *============================================================================*/
+
+/**
+ * The tlb_batch_init() function initializes the TLB batch pointed to
+ * by @p batch.
+ */
+PUBLIC void tlb_batch_init(struct tlb_batch *batch)
+{
+	if (batch != NULL)
+		batch->nops = 0;
+}
+
+/*============================================================================*
+ * tlb_batch_write()                                                          *
+ *============================================================================*/
+
+/**
+ * The tlb_batch_write() function adds to the TLB batch pointed to by
+ * @p batch a write of @p npages contiguous mappings starting at
+ * @p vaddr and @p paddr.
+ */
+PUBLIC int tlb_batch_write(
+	struct tlb_batch *batch,
+	int tlb_type,
+	vaddr_t vaddr,
+	paddr_t paddr,
+	size_t npages
+)
+{
+	return (tlb_batch_add(batch, TLB_BATCH_WRITE, tlb_type, vaddr, paddr, npages));
+}
+
+/*============================================================================*
+ * tlb_batch_inval()                                                          *
+ *============================================================================*/
+
+/**
+ * The tlb_batch_inval() function adds to the TLB batch pointed to by
+ * @p batch an invalidation of @p npages pages starting at @p vaddr.
+ */
+PUBLIC int tlb_batch_inval(
+	struct tlb_batch *batch,
+	int tlb_type,
+	vaddr_t vaddr,
+	size_t npages
+)
+{
+	return (tlb_batch_add(batch, TLB_BATCH_INVAL, tlb_type, vaddr, 0, npages));
+}
+
+/*============================================================================*
+ * tlb_batch_commit()                                                         *
+ *============================================================================*/
+
+/**
+ * The tlb_batch_commit() function applies, in order, all operations
+ * pending in the TLB batch pointed to by @p batch and then flushes
+ * the TLB once. The batch is left empty, even on failure.
+ *
+ * @note Hardware-managed TLBs drop stale translations while the
+ * operations are applied, thus they are not flushed again.
+ */
+PUBLIC int tlb_batch_commit(struct tlb_batch *batch)
+{
+	int ret;
+
+	/* Invalid batch. */
+	if (batch == NULL)
+		return (-EINVAL);
+
+	ret = 0;
+
+	for (int i = 0; i < batch->nops; i++)
+	{
+		if (batch->ops[i].op == TLB_BATCH_WRITE)
+		{
+			ret = tlb_write_range(
+				batch->ops[i].tlb_type,
+				batch->ops[i].vaddr,
+				batch->ops[i].paddr,
+				batch->ops[i].npages
+			);
+		}
+		else
+		{
+			ret = tlb_inval_range(
+				batch->ops[i].tlb_type,
+				batch->ops[i].vaddr,
+				batch->ops[i].npages
+			);
+		}
+
+		if (ret < 0)
+			break;
+	}
+
+	batch->nops = 0;
+
+	if (ret < 0)
+		return (ret);
+
+#ifdef TLB_SOFTWARE
+	ret = tlb_flush();
+#endif
+
+	return (ret);
+}
+
+/*============================================================================*
+ * tlb_shootdown_apply()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Invalidates a range in the TLB of the calling core.
+ *
+ * @param vaddr  Start virtual address.
+ * @param npages Number of pages.
+ */
+PRIVATE void tlb_shootdown_apply(vaddr_t vaddr, size_t npages)
+{
+#ifdef TLB_SOFTWARE
+	tlb_inval_range(TLB_INSTRUCTION, vaddr, npages);
+	tlb_inval_range(TLB_DATA, vaddr, npages);
+	tlb_flush();
+#else
+	tlb_inval_range(TLB_DATA, vaddr, npages);
+#endif
+}
+
+/*============================================================================*
+ * tlb_shootdown_setup()                                                      *
+ *============================================================================*/
+
+/**
+ * The tlb_shootdown_setup() function initializes the TLB shootdown
+ * mailboxes of all cores. It should be called once, before any core
+ * other than the master one is started.
+ */
+PUBLIC void tlb_shootdown_setup(void)
+{
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		spinlock_init(&mailboxes[i].lock);
+		mailboxes[i].nreqs = 0;
+		mailboxes[i].overflow = 0;
+		mailboxes[i].notified = 0;
+		mailboxes[i].posted = 0;
+		mailboxes[i].acked = 0;
+	}
+}
+
+/*============================================================================*
+ * tlb_shootdown_handle()                                                     *
+ *============================================================================*/
+
+/**
+ * The tlb_shootdown_handle() function drains the shootdown mailbox
+ * of the calling core, invalidating all requested ranges in its TLB,
+ * and then acknowledges them. Cores call it from their IPI handler,
+ * when they are woken up, and while waiting for their own
+ * shootdowns to complete.
+ */
+PUBLIC void tlb_shootdown_handle(void)
+{
+	int nreqs;
+	int overflow;
+	unsigned irqs;
+	uint32_t ticket;
+	int coreid = core_get_id();
+	struct
+	{
+		vaddr_t vaddr;
+		size_t npages;
+	} reqs[TLB_SHOOTDOWN_LENGTH];
+
+	/* Nothing to do. */
+	if (mailboxes[coreid].acked == mailboxes[coreid].posted)
+		return;
+
+	irqs = tlb_shootdown_irq_save();
+	spinlock_lock(&mailboxes[coreid].lock);
+
+		nreqs = mailboxes[coreid].nreqs;
+		overflow = mailboxes[coreid].overflow;
+		ticket = mailboxes[coreid].posted;
+
+		for (int i = 0; i < nreqs; i++)
+		{
+			reqs[i].vaddr = mailboxes[coreid].reqs[i].vaddr;
+			reqs[i].npages = mailboxes[coreid].reqs[i].npages;
+		}
+
+		mailboxes[coreid].nreqs = 0;
+		mailboxes[coreid].overflow = 0;
+		mailboxes[coreid].notified = 0;
+
+	spinlock_unlock(&mailboxes[coreid].lock);
+	tlb_shootdown_irq_restore(irqs);
+
+	if (overflow)
+		tlb_shootdown_apply(0, ~((size_t) 0));
+	else
+	{
+		for (int i = 0; i < nreqs; i++)
+			tlb_shootdown_apply(reqs[i].vaddr, reqs[i].npages);
+	}
+
+	hal_mb();
+	mailboxes[coreid].acked = ticket;
+}
+
+/*============================================================================*
+ * tlb_shootdown_post()                                                       *
+ *============================================================================*/
+
+/**
+ * The tlb_shootdown_post() function requests the cores in @p coremask
+ * to invalidate the @p npages pages starting at @p vaddr from their
+ * TLB, and returns without waiting for them. Cores that cannot cache
+ * any page in the range are skipped. If the calling core is in
+ * @p coremask, it invalidates the range right away.
+ *
+ * Requests are merged with pending ones on contiguous ranges, and a
+ * target core that already has an unhandled IPI is not notified
+ * again, so that concurrent shootdowns are served in a single round.
+ *
+ * @note Acknowledgments are stored in @p token and should be
+ * collected with tlb_shootdown_done() or tlb_shootdown_wait().
+ */
+PUBLIC int tlb_shootdown_post(
+	uint32_t coremask,
+	vaddr_t vaddr,
+	size_t npages,
+	struct tlb_shootdown_token *token
+)
+{
+	int notify;
+	unsigned irqs;
+	int coreid = core_get_id();
+
+	/* Invalid token. */
+	if (token == NULL)
+		return (-EINVAL);
+
+	token->coremask = 0;
+
+	/* Nothing to do. */
+	if (npages == 0)
+		return (0);
+
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		int last;
+
+		/* Not a target core. */
+		if (!(coremask & (1u << i)))
+			continue;
+
+		/* Local invalidation. */
+		if (i == coreid)
+		{
+			tlb_shootdown_apply(vaddr, npages);
+			continue;
+		}
+
+		/* Target core does not cache this range. */
+		if (!tlb_may_cache(i, vaddr, npages))
+			continue;
+
+		irqs = tlb_shootdown_irq_save();
+		spinlock_lock(&mailboxes[i].lock);
+
+			last = mailboxes[i].nreqs - 1;
+
+			/* Merge with last request. */
+			if ((last >= 0) &&
+				(mailboxes[i].reqs[last].vaddr + mailboxes[i].reqs[last].npages*PAGE_SIZE == vaddr))
+				mailboxes[i].reqs[last].npages += npages;
+
+			/* Append request. */
+			else if (mailboxes[i].nreqs < TLB_SHOOTDOWN_LENGTH)
+			{
+				mailboxes[i].reqs[last + 1].vaddr = vaddr;
+				mailboxes[i].reqs[last + 1].npages = npages;
+				mailboxes[i].nreqs++;
+			}
+
+			/* Mailbox is full. */
+			else
+				mailboxes[i].overflow = 1;
+
+			token->tickets[i] = ++mailboxes[i].posted;
+			token->coremask |= (1u << i);
+
+			notify = !mailboxes[i].notified;
+			mailboxes[i].notified = 1;
+
+		spinlock_unlock(&mailboxes[i].lock);
+		tlb_shootdown_irq_restore(irqs);
+
+		if (notify)
+			tlb_shootdown_notify(i);
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * tlb_shootdown_done()                                                       *
+ *============================================================================*/
+
+/**
+ * The tlb_shootdown_done() function checks which target cores of the
+ * shootdown tracked by @p token have acknowledged it, and drops them
+ * from the token.
+ */
+PUBLIC int tlb_shootdown_done(struct tlb_shootdown_token *token)
+{
+	/* Invalid token. */
+	if (token == NULL)
+		return (1);
+
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		if (!(token->coremask & (1u << i)))
+			continue;
+
+		/* Acknowledged. */
+		if ((int32_t)(mailboxes[i].acked - token->tickets[i]) >= 0)
+			token->coremask &= ~(1u << i);
+	}
+
+	return (token->coremask == 0);
+}
+
+/*============================================================================*
+ * tlb_shootdown_wait()                                                       *
+ *============================================================================*/
+
+/**
+ * The tlb_shootdown_wait() function waits until all target cores of
+ * the shootdown tracked by @p token have acknowledged it. Meanwhile,
+ * the calling core serves shootdowns sent to it, so that two cores
+ * shooting down each other do not deadlock.
+ */
+PUBLIC void tlb_shootdown_wait(struct tlb_shootdown_token *token)
+{
+	while (!tlb_shootdown_done(token))
+		tlb_shootdown_handle();
+}
+
+/*============================================================================*
+ * tlb_shootdown()                                                            *
+ *============================================================================*/
+
+/**
+ * The tlb_shootdown() function invalidates the @p npages pages
+ * starting at @p vaddr from the TLB of all cores in @p coremask, and
+ * waits for them to acknowledge it.
+ *
+ * @see tlb_shootdown_post(), tlb_shootdown_wait().
+ */
+PUBLIC int tlb_shootdown(uint32_t coremask, vaddr_t vaddr, size_t npages)
+{
+	int ret;
+	struct tlb_shootdown_token token;
+
+	if ((ret = tlb_shootdown_post(coremask, vaddr, npages, &token)) < 0)
+		return (ret);
+
+	tlb_shootdown_wait(&token);
+
+	return (0);
+}
+
+/*============================================================================*
+ * tlb_asid_init()                                                            *
+ *============================================================================*/
+
+/**
+ * The tlb_asid_init() function initializes the address space
+ * identifier pointed to by @p asid. An ASID is assigned to it on its
+ * first switch.
+ */
+PUBLIC void tlb_asid_init(struct tlb_asid *asid)
+{
+	if (asid != NULL)
+		asid->id = 0;
+}
+
+#if defined(__tlb_asid_set_fn)
+
+/**
+ * @brief Number of address space identifiers.
+ */
+#define TLB_ASID_NUM (1u << TLB_ASID_BITS)
+
+/**
+ * @brief Mask of address space identifiers.
+ */
+#define TLB_ASID_MASK (TLB_ASID_NUM - 1)
+
+/**
+ * @brief ASID allocator.
+ *
+ * ASIDs are handed out in increasing order within a generation. When
+ * they run out, a new generation starts, and every core flushes its
+ * TLB before it switches to an ASID of the new generation. ASID zero
+ * is reserved for the kernel.
+ */
+PRIVATE struct
+{
+	spinlock_t lock;              /**< Lock.                    */
+	volatile uint32_t generation; /**< Current generation.      */
+	uint32_t next;                /**< Next free ASID.          */
+	volatile uint32_t stale;      /**< Cores that should flush. */
+} asids = {
+	.lock = SPINLOCK_UNLOCKED,
+	.generation = TLB_ASID_NUM,
+	.next = 1,
+	.stale = 0,
+};
+
+/*============================================================================*
+ * tlb_switch_asid()                                                          *
+ *============================================================================*/
+
+/**
+ * The tlb_switch_asid() function switches the TLB of the calling core
+ * to the address space identified by @p asid, assigning it a fresh
+ * ASID if it has none of the current generation. Switching between
+ * address spaces whose ASIDs are current does not flush the TLB.
+ */
+PUBLIC int tlb_switch_asid(struct tlb_asid *asid)
+{
+	uint32_t id;
+	int coreid = core_get_id();
+
+	/* Invalid ASID. */
+	if (asid == NULL)
+		return (-EINVAL);
+
+	id = asid->id;
+
+	/* Slow path: assign ASID. */
+	if ((id & ~TLB_ASID_MASK) != asids.generation)
+	{
+		spinlock_lock(&asids.lock);
+
+			id = asid->id;
+
+			if ((id & ~TLB_ASID_MASK) != asids.generation)
+			{
+				/* Rollover. */
+				if (asids.next == TLB_ASID_NUM)
+				{
+					asids.stale = ~0u;
+					hal_wmb();
+
+					/* Generation zero means unassigned. */
+					if ((asids.generation += TLB_ASID_NUM) == 0)
+						asids.generation = TLB_ASID_NUM;
+					asids.next = 1;
+				}
+
+				id = asids.generation | asids.next++;
+				asid->id = id;
+			}
+
+		spinlock_unlock(&asids.lock);
+	}
+
+	/* Drop entries of the previous generation. */
+	hal_rmb();
+	if (asids.stale & (1u << coreid))
+	{
+		atomic_fetch_and(&asids.stale, ~(1u << coreid));
+
+		tlb_inval_range(TLB_INSTRUCTION, 0, ~((size_t) 0));
+		tlb_inval_range(TLB_DATA, 0, ~((size_t) 0));
+		tlb_flush();
+	}
+
+	return (tlb_asid_set(id & TLB_ASID_MASK));
+}
+
+#endif
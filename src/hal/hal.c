@@ -35,7 +35,10 @@
  * HAL, by starting up the following essential modules:
  *
  * - Log System
+ * - Clock System
  * - Interrupt System
+ * - Interrupt-Driven Standard Output, if supported
+ * - TLB Shootdown System
  *
  * The overlying kernel should call hal_init() before using the HAL.
  *
@@ -51,5 +54,8 @@ PUBLIC void hal_init(void)
 	KASSERT_SIZE(sizeof(struct exception), EXCEPTION_SIZE);
 	KASSERT(ALIGNED(sizeof(struct exception), DWORD_SIZE));
 
+	clock_setup();
 	interrupt_setup();
+	stdout_irq_setup();
+	tlb_shootdown_setup();
 }
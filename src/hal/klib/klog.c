@@ -0,0 +1,49 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/log.h>
+#include <nanvix/const.h>
+#include <nanvix/klib.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+/**
+ * The klog_write() function records the format string pointed to by
+ * @p fmt and the @p nargs arguments that follow it in the binary
+ * HAL log. Formatting is deferred to when the log is drained.
+ *
+ * @see klog().
+ */
+PUBLIC void klog_write(int nargs, const char *fmt, ...)
+{
+	va_list args;
+	uint32_t words[HAL_LOG_RECORD_ARGS] = { 0, 0, 0, 0 };
+
+	va_start(args, fmt);
+	for (int i = 0; (i < nargs) && (i < HAL_LOG_RECORD_ARGS); i++)
+		words[i] = va_arg(args, uint32_t);
+	va_end(args);
+
+	hal_log_record(fmt, words);
+}
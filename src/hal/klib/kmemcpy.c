@@ -24,6 +24,7 @@
 
 #include <nanvix/hal/hal.h>
 #include <nanvix/const.h>
+#include <nanvix/klib.h>
 
 /**
  * @brief Copy bytes in memory.
@@ -32,21 +33,80 @@
  * @param src  Source memory area.
  * @param n    Number of bytes to be copied.
  *
+ * The kmemcpy() function copies @p n bytes from @p src to @p dest.
+ * Whenever both memory areas agree on word alignment, bytes are
+ * copied in a word basis, otherwise a byte-wise copy is performed.
+ * Memory areas should not overlap.
+ *
  * @returns A pointer to the target memory area.
+ *
+ * @see kmemmove()
  */
 PUBLIC void *kmemcpy(void *dest, const void *src, size_t n)
 {
-    char *d;       /* Write pointer. */
-    const char* s; /* Read pointer.  */
+	unsigned char *d;       /* Write pointer. */
+	const unsigned char *s; /* Read pointer.  */
 
-    s = src;
-    d = dest;
+	s = src;
+	d = dest;
 
-    while (n-- > 0)
+	if ((n >= KWORD_SIZE) && KWORD_CONGRUENT(d, s))
 	{
-    	*d++ = *s++;
-		dcache_invalidate();
+		kword_t *dw;       /* Word write pointer. */
+		const kword_t *sw; /* Word read pointer.  */
+
+		/* Copy head. */
+		while (!ALIGNED((uintptr_t) d, KWORD_SIZE))
+		{
+			*d++ = *s++;
+			n--;
+		}
+
+		dw = (kword_t *) d;
+		sw = (const kword_t *) s;
+
+		/* Copy body. */
+		for ( ; n >= 4*KWORD_SIZE; n -= 4*KWORD_SIZE)
+		{
+			dw[0] = sw[0];
+			dw[1] = sw[1];
+			dw[2] = sw[2];
+			dw[3] = sw[3];
+			dw += 4;
+			sw += 4;
+		}
+		for ( ; n >= KWORD_SIZE; n -= KWORD_SIZE)
+			*dw++ = *sw++;
+
+		d = (unsigned char *) dw;
+		s = (const unsigned char *) sw;
 	}
 
-    return (d);
+	/* Copy tail. */
+	while (n-- > 0)
+		*d++ = *s++;
+
+	return (dest);
+}
+
+/**
+ * @brief Copy bytes in memory and makes them visible to other cores.
+ *
+ * @param dest Target memory area.
+ * @param src  Source memory area.
+ * @param n    Number of bytes to be copied.
+ *
+ * The kmemcpy_coherent() function works as kmemcpy(), but it also
+ * performs a data cache maintenance operation once the copy is
+ * done. It should be used when the target memory area is going to
+ * be read by some other core or by an external agent.
+ *
+ * @returns A pointer to the target memory area.
+ */
+PUBLIC void *kmemcpy_coherent(void *dest, const void *src, size_t n)
+{
+	kmemcpy(dest, src, n);
+	dcache_flush_range(dest, n);
+
+	return (dest);
 }
@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/const.h>
+#include <nanvix/klib.h>
+
+/**
+ * @brief Copy bytes in memory, handling overlapping areas.
+ *
+ * @param dest Target memory area.
+ * @param src  Source memory area.
+ * @param n    Number of bytes to be copied.
+ *
+ * The kmemmove() function copies @p n bytes from @p src to @p dest.
+ * Memory areas may overlap.
+ *
+ * @returns A pointer to the target memory area.
+ */
+PUBLIC void *kmemmove(void *dest, const void *src, size_t n)
+{
+	unsigned char *d;       /* Write pointer. */
+	const unsigned char *s; /* Read pointer.  */
+
+	/* Forward copy is safe. */
+	if (((uintptr_t) dest <= (uintptr_t) src) ||
+		((uintptr_t) dest >= (uintptr_t) src + n))
+		return (kmemcpy(dest, src, n));
+
+	/* Copy backwards. */
+	d = (unsigned char *) dest + n;
+	s = (const unsigned char *) src + n;
+
+	if ((n >= KWORD_SIZE) && KWORD_CONGRUENT(d, s))
+	{
+		kword_t *dw;       /* Word write pointer. */
+		const kword_t *sw; /* Word read pointer.  */
+
+		/* Copy tail. */
+		while (!ALIGNED((uintptr_t) d, KWORD_SIZE))
+		{
+			*--d = *--s;
+			n--;
+		}
+
+		dw = (kword_t *) d;
+		sw = (const kword_t *) s;
+
+		/* Copy body. */
+		for ( ; n >= 4*KWORD_SIZE; n -= 4*KWORD_SIZE)
+		{
+			dw -= 4;
+			sw -= 4;
+			dw[3] = sw[3];
+			dw[2] = sw[2];
+			dw[1] = sw[1];
+			dw[0] = sw[0];
+		}
+		for ( ; n >= KWORD_SIZE; n -= KWORD_SIZE)
+			*--dw = *--sw;
+
+		d = (unsigned char *) dw;
+		s = (const unsigned char *) sw;
+	}
+
+	/* Copy head. */
+	while (n-- > 0)
+		*--d = *--s;
+
+	return (dest);
+}
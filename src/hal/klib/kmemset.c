@@ -24,6 +24,7 @@
 
 #include <nanvix/hal/hal.h>
 #include <nanvix/const.h>
+#include <nanvix/klib.h>
 
 /**
  * @brief Sets bytes in memory.
@@ -32,20 +33,54 @@
  * @param c   Character to use.
  * @param n   Number of bytes to be set.
  *
+ * The kmemset() function fills the first @p n bytes of the memory
+ * area pointed to by @p ptr with the constant byte @p c. Unaligned
+ * head and tail bytes are set one at a time, and the remainder is
+ * set in a word basis.
+ *
  * @returns A pointer to the target memory area.
  */
 PUBLIC void *kmemset(void *ptr, int c, size_t n)
 {
-    unsigned char *p;
+	unsigned char *p;
 
-    p = ptr;
+	p = ptr;
 
-    /* Set bytes. */
-    while (n-- > 0)
+	if (n >= KWORD_SIZE)
 	{
-		*p++ = (unsigned char) c;
-		dcache_invalidate();
+		kword_t *pw;     /* Word write pointer. */
+		kword_t pattern; /* Fill pattern.       */
+
+		/* Replicate byte over a word. */
+		pattern = (((kword_t) -1)/0xff)*((unsigned char) c);
+
+		/* Set head. */
+		while (!ALIGNED((uintptr_t) p, KWORD_SIZE))
+		{
+			*p++ = (unsigned char) c;
+			n--;
+		}
+
+		pw = (kword_t *) p;
+
+		/* Set body. */
+		for ( ; n >= 4*KWORD_SIZE; n -= 4*KWORD_SIZE)
+		{
+			pw[0] = pattern;
+			pw[1] = pattern;
+			pw[2] = pattern;
+			pw[3] = pattern;
+			pw += 4;
+		}
+		for ( ; n >= KWORD_SIZE; n -= KWORD_SIZE)
+			*pw++ = pattern;
+
+		p = (unsigned char *) pw;
 	}
 
-    return (ptr);	
+	/* Set tail. */
+	while (n-- > 0)
+		*p++ = (unsigned char) c;
+
+	return (ptr);
 }
@@ -43,12 +43,18 @@ PUBLIC void kpanic(const char *fmt, ...)
 	
 	/* Convert to raw string. */
 	va_start(args, fmt);
-	len = kvsprintf(buffer + 7, fmt, args) + 7;
+	len = kvsnprintf(buffer + 7, KBUFFER_SIZE - 7, fmt, args) + 7;
 	buffer[len++] = '\n';
 	buffer[len++] = '\0';
 	va_end(args);
 
-	kputs(buffer);
+	/*
+	 * Another core may be draining the log, so
+	 * write the message synchronously instead.
+	 */
+	hal_log_drain();
+	stdout_write(buffer, len - 1);
+	stdout_flush();
 
 	/* I don't want to be troubled. */
 	interrupts_disable();
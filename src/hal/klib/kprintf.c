@@ -39,7 +39,7 @@ PUBLIC void kprintf(const char *fmt, ...)
 
 	/* Convert to raw string. */
 	va_start(args, fmt);
-	len = kvsprintf(buffer, fmt, args);
+	len = kvsnprintf(buffer, KBUFFER_SIZE, fmt, args);
 	buffer[len++] = '\n';
 	buffer[len++] = '\0';
 	va_end(args);
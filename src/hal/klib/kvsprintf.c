@@ -23,84 +23,357 @@
  */
 
 #include <nanvix/const.h>
+#include <nanvix/klib.h>
 #include <stdarg.h>
+#include <stdint.h>
 
-#ifndef __HAS_HW_DIVISION
-#include <nanvix/klib.h>
-#endif
+/**
+ * @brief Powers of ten that fit in 32 bits, in descending order.
+ */
+PRIVATE const uint32_t pow10_32[10] = {
+	1000000000U, 100000000U, 10000000U, 1000000U, 100000U,
+	10000U, 1000U, 100U, 10U, 1U
+};
+
+/**
+ * @brief Powers of ten that fit in 64 bits, in descending order.
+ */
+PRIVATE const uint64_t pow10_64[20] = {
+	10000000000000000000ULL, 1000000000000000000ULL,
+	100000000000000000ULL, 10000000000000000ULL,
+	1000000000000000ULL, 100000000000000ULL,
+	10000000000000ULL, 1000000000000ULL,
+	100000000000ULL, 10000000000ULL,
+	1000000000ULL, 100000000ULL, 10000000ULL, 1000000ULL,
+	100000ULL, 10000ULL, 1000ULL, 100ULL, 10ULL, 1ULL
+};
+
+/**
+ * @brief Hexadecimal digits.
+ */
+PRIVATE const char hexdigits[16] = {
+	'0', '1', '2', '3', '4', '5', '6', '7',
+	'8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+};
 
 /**
- * @brief Converts an integer to a string.
+ * @brief Converts an unsigned integer to a decimal string.
  *
- * @param str  Output string.
- * @param num  Number to be converted.
- * @param base Base to use.
+ * @param str Output string.
+ * @param num Number to be converted.
+ *
+ * Each digit is obtained by subtracting powers of ten from @p num,
+ * so that no division is required. This matters on cores without a
+ * hardware divider, where each division is a bit-by-bit loop.
  *
  * @returns The length of the output string.
  */
-PRIVATE int itoa(char *str, unsigned num, int base)
+PRIVATE int utoa10(char *str, uint64_t num)
 {
-	char *b = str;
-	char *p, *p1, *p2;
-	unsigned divisor;
+	int i = 0;
+	int len = 0;
 
-#ifdef __HAS_HW_DIVISION
+	/* 32-bit numbers. */
+	if (num <= 0xffffffffULL)
+	{
+		uint32_t n = (uint32_t) num;
 
-	if (base == 'd')
-		divisor = 10;
+		/* Skip leading zeros. */
+		while ((i < 9) && (n < pow10_32[i]))
+			i++;
 
-	else
-	{
-		*b++ = '0'; *b++ = 'x';
-		divisor = 16;
+		for ( ; i < 10; i++)
+		{
+			char digit = '0';
+
+			while (n >= pow10_32[i])
+			{
+				n -= pow10_32[i];
+				digit++;
+			}
+
+			str[len++] = digit;
+		}
+
+		return (len);
 	}
 
-	p = b;
+	/* Skip leading zeros. */
+	while (num < pow10_64[i])
+		i++;
 
-	/* Convert number. */
-	do
+	for ( ; i < 20; i++)
 	{
-		unsigned remainder = num % divisor;
+		char digit = '0';
 
-		*p++ = (remainder < 10) ? remainder + '0' :
-		                          remainder + 'a' - 10;
-	} while (num /= divisor);
+		while (num >= pow10_64[i])
+		{
+			num -= pow10_64[i];
+			digit++;
+		}
 
-#else
+		str[len++] = digit;
+	}
 
-	UNUSED(base);
+	return (len);
+}
 
-	*b++ = '0'; *b++ = 'x';
-	divisor = 16;
+/**
+ * @brief Converts an unsigned integer to a hexadecimal string.
+ *
+ * @param str     Output string.
+ * @param num     Number to be converted.
+ * @param ndigits Number of digits to output.
+ *
+ * @returns The length of the output string.
+ */
+PRIVATE int utoa16(char *str, uint32_t num, int ndigits)
+{
+	for (int i = ndigits - 1; i >= 0; i--)
+	{
+		str[i] = hexdigits[num & 0xf];
+		num >>= 4;
+	}
+
+	return (ndigits);
+}
 
-	p = b;
+/**
+ * @brief Bounded output string.
+ */
+struct kbuffer
+{
+	char *str;   /**< Output string.       */
+	size_t len;  /**< Characters written.  */
+	size_t size; /**< Size of the string.  */
+};
 
-	/* Convert number. */
-	do
+/**
+ * @brief Appends a character to a bounded output string.
+ *
+ * @param buf Target output string.
+ * @param ch  Character to append.
+ *
+ * @note One position is always kept for the null terminator.
+ */
+static inline void kbuffer_put(struct kbuffer *buf, char ch)
+{
+	if ((buf->len + 1) < buf->size)
+		buf->str[buf->len++] = ch;
+}
+
+/**
+ * @brief Appends a padded field to a bounded output string.
+ *
+ * @param buf   Target output string.
+ * @param field Field to append.
+ * @param len   Length of the field.
+ * @param width Minimum width of the field.
+ * @param pad   Padding character.
+ * @param left  Left justify the field?
+ */
+PRIVATE void kbuffer_field(
+	struct kbuffer *buf,
+	const char *field,
+	int len,
+	int width,
+	char pad,
+	int left
+)
+{
+	/* Right justify. */
+	if (!left)
 	{
-		unsigned remainder = num  & 0xf;
+		for ( ; width > len; width--)
+			kbuffer_put(buf, pad);
+	}
 
-		*p++ = (remainder < 10) ? remainder + '0' :
-		                          remainder + 'a' - 10;
-	} while ((num  = (num >> 4)));
+	for (int i = 0; i < len; i++)
+		kbuffer_put(buf, field[i]);
+
+	/* Left justify. */
+	for ( ; width > len; width--)
+		kbuffer_put(buf, ' ');
+}
 
-#endif
+/**
+ * The kvsnprintf() function writes at most @p size bytes, including
+ * the null terminator, of formatted data from the variable
+ * argument list @p args to the string pointed to by @p str. The
+ * following conversions are supported:
+ *
+ * - %c: character.
+ * - %d, %u: signed and unsigned decimal numbers.
+ * - %x: hexadecimal number, with 0x prefix and 8 digits.
+ * - %s: string.
+ * - %%: percent sign.
+ *
+ * The 'll' length modifier selects 64-bit numbers. A conversion may
+ * be preceded by the '-' and '0' flags, a minimum field width, and a
+ * precision. The precision sets the minimum number of digits of
+ * decimal numbers, and the maximum number of characters of strings.
+ */
+PUBLIC int kvsnprintf(char *str, size_t size, const char *fmt, va_list args)
+{
+	struct kbuffer buf;
+	char num[24];
+	const char *s;
 
-	/* Fill up with zeros. */
-	if (divisor == 16)
-		while ((p - b) < 8)
-			*p++ = '0';
+	buf.str = str;
+	buf.len = 0;
+	buf.size = size;
 
-	/* Reverse BUF. */
-	p1 = b; p2 = p - 1;
-	while (p1 < p2)
+	/* Format string. */
+	for ( ; *fmt != '\0'; fmt++)
 	{
-		char tmp = *p1;
-		*p1++ = *p2;
-		*p2-- = tmp;
+		int left = 0;       /* Left justify?          */
+		char pad = ' ';     /* Padding character.     */
+		int width = 0;      /* Minimum field width.   */
+		int precision = -1; /* Precision.             */
+		int wide = 0;       /* 64-bit number?         */
+		int len = 0;        /* Length of the number.  */
+		uint64_t n;         /* Number to convert.     */
+
+		/* No conversion needed. */
+		if (*fmt != '%')
+		{
+			kbuffer_put(&buf, *fmt);
+			continue;
+		}
+
+		/* Parse flags. */
+		for (fmt++; (*fmt == '-') || (*fmt == '0'); fmt++)
+		{
+			if (*fmt == '-')
+				left = 1;
+			else
+				pad = '0';
+		}
+
+		/* Parse width. */
+		for ( ; (*fmt >= '0') && (*fmt <= '9'); fmt++)
+			width = width*10 + (*fmt - '0');
+
+		/* Parse precision. */
+		if (*fmt == '.')
+		{
+			precision = 0;
+			for (fmt++; (*fmt >= '0') && (*fmt <= '9'); fmt++)
+				precision = precision*10 + (*fmt - '0');
+		}
+
+		/* Parse length. */
+		if (*fmt == 'l')
+		{
+			if (*(++fmt) == 'l')
+			{
+				wide = 1;
+				fmt++;
+			}
+		}
+
+		/* Parse conversion. */
+		switch (*fmt)
+		{
+			/* Character. */
+			case 'c':
+				num[0] = (char) va_arg(args, int);
+				kbuffer_field(&buf, num, 1, width, ' ', left);
+				break;
+
+			/* Decimal number. */
+			case 'd':
+			case 'u':
+			{
+				int ndigits;
+				char digits[20];
+
+				/* Signed. */
+				if (*fmt == 'd')
+				{
+					int64_t d;
+
+					d = (wide) ? va_arg(args, long long) : va_arg(args, int);
+
+					if (d < 0)
+					{
+						num[len++] = '-';
+						n = (uint64_t) 0 - (uint64_t) d;
+					}
+					else
+						n = (uint64_t) d;
+				}
+
+				/* Unsigned. */
+				else
+				{
+					n = (wide) ?
+						va_arg(args, unsigned long long) :
+						va_arg(args, unsigned);
+				}
+
+				ndigits = utoa10(digits, n);
+
+				/* Leading zeros. */
+				if (precision > 20)
+					precision = 20;
+				for ( ; precision > ndigits; precision--)
+					num[len++] = '0';
+
+				for (int i = 0; i < ndigits; i++)
+					num[len++] = digits[i];
+
+				kbuffer_field(&buf, num, len, width, pad, left);
+				break;
+			}
+
+			/* Hexadecimal number. */
+			case 'x':
+				num[len++] = '0';
+				num[len++] = 'x';
+				if (wide)
+				{
+					n = va_arg(args, unsigned long long);
+					len += utoa16(&num[len], (uint32_t) (n >> 32), 8);
+					len += utoa16(&num[len], (uint32_t) n, 8);
+				}
+				else
+				{
+					n = va_arg(args, unsigned);
+					len += utoa16(&num[len], (uint32_t) n, 8);
+				}
+				kbuffer_field(&buf, num, len, width, pad, left);
+				break;
+
+			/* String. */
+			case 's':
+				s = va_arg(args, const char *);
+				while ((s[len] != '\0') && ((precision < 0) || (len < precision)))
+					len++;
+				kbuffer_field(&buf, s, len, width, ' ', left);
+				break;
+
+			/* Percent sign. */
+			case '%':
+				kbuffer_put(&buf, '%');
+				break;
+
+			/* End of format string. */
+			case '\0':
+				fmt--;
+				break;
+
+			/* Ignore. */
+			default:
+				break;
+		}
 	}
 
-	return(p - str);
+	/* Terminate string. */
+	if (size > 0)
+		str[buf.len] = '\0';
+
+	return (buf.len);
 }
 
 /**
@@ -111,49 +384,10 @@ PRIVATE int itoa(char *str, unsigned num, int base)
  * @param args Variable arguments list.
  *
  * @returns The length of the output string.
+ *
+ * @see kvsnprintf().
  */
 PUBLIC int kvsprintf(char *str, const char *fmt, va_list args)
 {
-	char *base = str;
-	char *s;
-
-    /* Format string. */
-    while (*fmt != '\0')
-    {
-        /* No conversion needed. */
-        if (*fmt != '%')
-            *str++ = *fmt;
-
-        /* Parse format. */
-        else
-            switch (*(++fmt))
-            {
-				/* Character. */
-                case 'c':
-					*str++ = (char)va_arg(args, int);
-					break;
-
-				/* Number. */
-				case 'd':
-					str += itoa(str, va_arg(args, unsigned int), 'd');
-					break;
-				case 'x':
-					str += itoa(str, va_arg(args, unsigned int), 'x');
-					break;
-
-				/* String. */
-                case 's':
-					s = va_arg(args, char*);
-                    while (*s != '\0')
-						*str++ = *s++;
-					break;
-
-                /* Ignore. */
-                default:
-                    break;
-            }
-        fmt++;
-    }
-
-    return (str - base);
+	return (kvsnprintf(str, ~((size_t) 0), fmt, args));
 }
@@ -22,139 +22,369 @@
  * SOFTWARE.
  */
 
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <stdint.h>
+
 /*
- * Copyright (C) 2000-2019 Free Software Foundation, Inc.
- *
- * This file is part of GCC.
+ * Software division runtime. The compiler emits calls to these
+ * routines for divisions that the core cannot perform in hardware:
+ * all divisions on cores without a divider, and 64-bit divisions on
+ * every 32-bit core.
+ */
+
+/* Forward definitions. */
+EXTERN uint32_t __udivsi3(uint32_t, uint32_t);
+EXTERN uint32_t __umodsi3(uint32_t, uint32_t);
+EXTERN int32_t __divsi3(int32_t, int32_t);
+EXTERN int32_t __modsi3(int32_t, int32_t);
+EXTERN uint64_t __udivmoddi4(uint64_t, uint64_t, uint64_t *);
+EXTERN uint64_t __udivdi3(uint64_t, uint64_t);
+EXTERN uint64_t __umoddi3(uint64_t, uint64_t);
+EXTERN int64_t __divdi3(int64_t, int64_t);
+EXTERN int64_t __moddi3(int64_t, int64_t);
+
+/*============================================================================*
+ * 64-bit Helpers                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Builds a 64-bit number out of two 32-bit halves.
+ */
+#define MAKE64(hi, lo) ((((uint64_t) (hi)) << 32) | ((uint64_t) (lo)))
 
- * GCC is free software; you can redistribute it and/or modify it
- * under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 3, or (at your option)
- * any later version.
+/**
+ * @brief Gets the high half of a 64-bit number.
+ */
+#define HI32(x) ((uint32_t) ((x) >> 32))
+
+/**
+ * @brief Gets the low half of a 64-bit number.
+ */
+#define LO32(x) ((uint32_t) (x))
+
+/**
+ * @brief Shifts a 64-bit number left.
  *
- * GCC is distributed in the hope that it will be useful, but WITHOUT
- * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
- * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
- * License for more details.
+ * @param x     Target number.
+ * @param shift Shift amount (0 to 63).
  *
- * Under Section 7 of GPL version 3, you are granted additional
- * permissions described in the GCC Runtime Library Exception, version
- * 3.1, as published by the Free Software Foundation.
+ * @note Variable shifts are built from 32-bit ones, so that no
+ * shift helper from the compiler runtime is required.
+ */
+static inline uint64_t shl64(uint64_t x, int shift)
+{
+	uint32_t hi = HI32(x);
+	uint32_t lo = LO32(x);
+
+	if (shift >= 32)
+		return (MAKE64(lo << (shift - 32), 0));
+
+	if (shift > 0)
+		return (MAKE64((hi << shift) | (lo >> (32 - shift)), lo << shift));
+
+	return (x);
+}
+
+/**
+ * @brief Shifts a 64-bit number right.
  *
- * You should have received a copy of the GNU General Public License
- * and a copy of the GCC Runtime Library Exception along with this
- * program; see the files COPYING3 and COPYING.RUNTIME respectively.
- * If not, see <http://www.gnu.org/licenses/>.
+ * @param x     Target number.
+ * @param shift Shift amount (0 to 63).
  */
+static inline uint64_t shr64(uint64_t x, int shift)
+{
+	uint32_t hi = HI32(x);
+	uint32_t lo = LO32(x);
+
+	if (shift >= 32)
+		return (MAKE64(0, hi >> (shift - 32)));
 
-unsigned long
-__udivmodsi4(unsigned long num, unsigned long den, int modwanted)
+	if (shift > 0)
+		return (MAKE64(hi >> shift, (lo >> shift) | (hi << (32 - shift))));
+
+	return (x);
+}
+
+/**
+ * @brief Counts leading zero bits of a non-zero 64-bit number.
+ */
+static inline int clz64(uint64_t x)
 {
-  unsigned long bit = 1;
-  unsigned long res = 0;
-
-  while (den < num && bit && !(den & (1L<<31)))
-    {
-      den <<=1;
-      bit <<=1;
-    }
-  while (bit)
-    {
-      if (num >= den)
-	{
-	  num -= den;
-	  res |= bit;
-	}
-      bit >>=1;
-      den >>=1;
-    }
-  if (modwanted) return num;
-  return res;
+	return ((HI32(x) != 0) ? bit_clz(HI32(x)) : 32 + bit_clz(LO32(x)));
 }
 
-unsigned short
-__udivmodhi4(unsigned short num, unsigned short den, int modwanted)
+/**
+ * @brief Counts trailing zero bits of a non-zero 64-bit number.
+ */
+static inline int ctz64(uint64_t x)
 {
-  unsigned short bit = 1;
-  unsigned short res = 0;
-
-  while (den < num && bit && !(den & (1U<<15)))
-    {
-      den <<=1;
-      bit <<=1;
-    }
-  while (bit)
-    {
-      if (num >= den)
+	return ((LO32(x) != 0) ? bit_ctz(LO32(x)) : 32 + bit_ctz(HI32(x)));
+}
+
+/*============================================================================*
+ * 32-bit Division                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Divides two unsigned 32-bit numbers.
+ *
+ * @param num Dividend.
+ * @param den Divisor.
+ * @param rem Store location for the remainder.
+ *
+ * The divisor is aligned to the most significant bit of the
+ * dividend before the shift-subtract loop starts, so the loop runs
+ * once per quotient bit rather than once per bit of the word.
+ * Divisions by a power of two and by ten take no loop at all.
+ *
+ * @returns The quotient.
+ */
+PRIVATE uint32_t udivmod32(uint32_t num, uint32_t den, uint32_t *rem)
+{
+	int shift;
+	uint32_t quot;
+
+	/* Division by zero. */
+	if (den == 0)
+	{
+		*rem = num;
+		return (0xffffffff);
+	}
+
+	/* Quotient is zero. */
+	if (num < den)
+	{
+		*rem = num;
+		return (0);
+	}
+
+	/* Power of two. */
+	if ((den & (den - 1)) == 0)
+	{
+		*rem = num & (den - 1);
+		return (num >> bit_ctz(den));
+	}
+
+	/* Ten, used for decimal conversions. */
+	if (den == 10)
+	{
+		quot = (num >> 1) + (num >> 2);
+		quot += quot >> 4;
+		quot += quot >> 8;
+		quot += quot >> 16;
+		quot >>= 3;
+		*rem = num - ((quot << 3) + (quot << 1));
+
+		/* Fix estimate. */
+		if (*rem > 9)
+		{
+			*rem -= 10;
+			quot++;
+		}
+
+		return (quot);
+	}
+
+	/* Normalize divisor. */
+	shift = bit_clz(den) - bit_clz(num);
+	den <<= shift;
+
+	/* Shift-subtract loop. */
+	quot = 0;
+	for (int i = 0; i <= shift; i++)
 	{
-	  num -= den;
-	  res |= bit;
+		quot <<= 1;
+		if (num >= den)
+		{
+			num -= den;
+			quot |= 1;
+		}
+		den >>= 1;
 	}
-      bit >>=1;
-      den >>=1;
-    }
-  if (modwanted) return num;
-  return res;
+
+	*rem = num;
+
+	return (quot);
 }
 
-long
-__divsi3 (long a, long b)
+/**
+ * @brief Unsigned 32-bit division.
+ */
+PUBLIC uint32_t __udivsi3(uint32_t a, uint32_t b)
 {
-  int neg = 0;
-  long res;
+	uint32_t r;
 
-  if (a < 0)
-    {
-      a = -a;
-      neg = !neg;
-    }
+	return (udivmod32(a, b, &r));
+}
 
-  if (b < 0)
-    {
-      b = -b;
-      neg = !neg;
-    }
+/**
+ * @brief Unsigned 32-bit modulus.
+ */
+PUBLIC uint32_t __umodsi3(uint32_t a, uint32_t b)
+{
+	uint32_t r;
 
-  res = __udivmodsi4 (a, b, 0);
+	udivmod32(a, b, &r);
 
-  if (neg)
-    res = -res;
+	return (r);
+}
 
-  return res;
+/**
+ * @brief Signed 32-bit division.
+ */
+PUBLIC int32_t __divsi3(int32_t a, int32_t b)
+{
+	uint32_t q, r;
+	uint32_t ua = (a < 0) ? 0 - (uint32_t) a : (uint32_t) a;
+	uint32_t ub = (b < 0) ? 0 - (uint32_t) b : (uint32_t) b;
+
+	q = udivmod32(ua, ub, &r);
+
+	return ((int32_t) (((a < 0) != (b < 0)) ? 0 - q : q));
 }
 
-long
-__modsi3 (long a, long b)
+/**
+ * @brief Signed 32-bit modulus.
+ *
+ * @note The result takes the sign of the dividend.
+ */
+PUBLIC int32_t __modsi3(int32_t a, int32_t b)
 {
-  int neg = 0;
-  long res;
+	uint32_t r;
+	uint32_t ua = (a < 0) ? 0 - (uint32_t) a : (uint32_t) a;
+	uint32_t ub = (b < 0) ? 0 - (uint32_t) b : (uint32_t) b;
 
-  if (a < 0)
-    {
-      a = -a;
-      neg = 1;
-    }
+	udivmod32(ua, ub, &r);
 
-  if (b < 0)
-    b = -b;
+	return ((int32_t) ((a < 0) ? 0 - r : r));
+}
 
-  res = __udivmodsi4 (a, b, 1);
+/*============================================================================*
+ * 64-bit Division                                                            *
+ *============================================================================*/
 
-  if (neg)
-    res = -res;
+/**
+ * @brief Divides two unsigned 64-bit numbers.
+ *
+ * @param num Dividend.
+ * @param den Divisor.
+ * @param rem Store location for the remainder (may be NULL).
+ *
+ * Operands that fit in 32 bits are handed to the 32-bit routine, or
+ * to the hardware divider when the core has one. Otherwise, the same
+ * normalized shift-subtract scheme as udivmod32() is used.
+ *
+ * @returns The quotient.
+ */
+PUBLIC uint64_t __udivmoddi4(uint64_t num, uint64_t den, uint64_t *rem)
+{
+	int shift;
+	uint64_t quot;
 
-  return res;
+	/* Division by zero or quotient is zero. */
+	if ((den == 0) || (num < den))
+	{
+		if (rem != NULL)
+			*rem = num;
+		return ((den == 0) ? ~((uint64_t) 0) : 0);
+	}
+
+	/* Power of two. */
+	if ((den & (den - 1)) == 0)
+	{
+		if (rem != NULL)
+			*rem = num & (den - 1);
+		return (shr64(num, ctz64(den)));
+	}
+
+	/* 32-bit operands. */
+	if (HI32(num) == 0)
+	{
+		uint32_t r32;
+		uint32_t q32;
+
+#ifdef __HAS_HW_DIVISION
+		q32 = LO32(num) / LO32(den);
+		r32 = LO32(num) % LO32(den);
+#else
+		q32 = udivmod32(LO32(num), LO32(den), &r32);
+#endif
+
+		if (rem != NULL)
+			*rem = r32;
+		return (q32);
+	}
+
+	/* Normalize divisor. */
+	shift = clz64(den) - clz64(num);
+	den = shl64(den, shift);
+
+	/* Shift-subtract loop. */
+	quot = 0;
+	for (int i = 0; i <= shift; i++)
+	{
+		quot <<= 1;
+		if (num >= den)
+		{
+			num -= den;
+			quot |= 1;
+		}
+		den >>= 1;
+	}
+
+	if (rem != NULL)
+		*rem = num;
+
+	return (quot);
 }
 
-long
-__udivsi3 (long a, long b)
+/**
+ * @brief Unsigned 64-bit division.
+ */
+PUBLIC uint64_t __udivdi3(uint64_t a, uint64_t b)
 {
-  return __udivmodsi4 (a, b, 0);
+	return (__udivmoddi4(a, b, NULL));
 }
 
-long
-__umodsi3 (long a, long b)
+/**
+ * @brief Unsigned 64-bit modulus.
+ */
+PUBLIC uint64_t __umoddi3(uint64_t a, uint64_t b)
 {
-  return __udivmodsi4 (a, b, 1);
+	uint64_t r;
+
+	__udivmoddi4(a, b, &r);
+
+	return (r);
 }
 
+/**
+ * @brief Signed 64-bit division.
+ */
+PUBLIC int64_t __divdi3(int64_t a, int64_t b)
+{
+	uint64_t q;
+	uint64_t ua = (a < 0) ? 0 - (uint64_t) a : (uint64_t) a;
+	uint64_t ub = (b < 0) ? 0 - (uint64_t) b : (uint64_t) b;
+
+	q = __udivmoddi4(ua, ub, NULL);
+
+	return ((int64_t) (((a < 0) != (b < 0)) ? 0 - q : q));
+}
+
+/**
+ * @brief Signed 64-bit modulus.
+ *
+ * @note The result takes the sign of the dividend.
+ */
+PUBLIC int64_t __moddi3(int64_t a, int64_t b)
+{
+	uint64_t r;
+	uint64_t ua = (a < 0) ? 0 - (uint64_t) a : (uint64_t) a;
+	uint64_t ub = (b < 0) ? 0 - (uint64_t) b : (uint64_t) b;
+
+	__udivmoddi4(ua, ub, &r);
+
+	return ((int64_t) ((a < 0) ? 0 - r : r));
+}
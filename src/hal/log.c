@@ -22,54 +22,347 @@
  * SOFTWARE.
  */
 
+#include <nanvix/hal/hal.h>
 #include <nanvix/hal/target/stdout.h>
 #include <nanvix/hal/log.h>
 #include <nanvix/const.h>
 #include <nanvix/klib.h>
+#include <errno.h>
+#include <stdarg.h>
 #include <stdint.h>
 
 /**
- * @brief HAL log.
+ * @name Log Record Header
  */
-PRIVATE struct
+/**@{*/
+#define HAL_LOG_COMMITTED 0x80000000 /**< Committed record? */
+#define HAL_LOG_LENGTH    0x0000ffff /**< Length mask.      */
+/**@}*/
+
+/**
+ * @brief Size of a word in the log (in bytes).
+ */
+#define HAL_LOG_WORD_SIZE sizeof(uint32_t)
+
+/**
+ * @brief Maximum length of a record (in bytes).
+ */
+#define HAL_LOG_RECORD_MAX (HAL_LOG_SIZE/2 - HAL_LOG_WORD_SIZE)
+
+/**
+ * @brief Size of a record in the ring (in bytes).
+ *
+ * @param n Length of the record.
+ */
+#define HAL_LOG_RECORD_SIZE(n) \
+	(HAL_LOG_WORD_SIZE + (((n) + HAL_LOG_WORD_SIZE - 1) & ~(HAL_LOG_WORD_SIZE - 1)))
+
+/**
+ * @brief Offset of a position in the ring.
+ *
+ * @param x Free-running position.
+ */
+#define HAL_LOG_OFFSET(x) ((x) & (HAL_LOG_SIZE - 1))
+
+/**
+ * @brief Per-core HAL log.
+ *
+ * Each record is a header word, holding the length of the record and
+ * a commit flag, followed by the record itself, padded to a word
+ * boundary. Positions are free-running, and wrap around the ring.
+ * Records are reserved by writers and released by the drain step,
+ * which zeroes them out, so a newly reserved header is never seen as
+ * committed.
+ */
+PRIVATE struct hal_log
+{
+	uint32_t head;                                /**< Next record to drain. */
+	uint32_t tail;                                /**< Next free position.   */
+	uint32_t dropped;                             /**< Dropped records.      */
+	uint32_t buf[HAL_LOG_SIZE/HAL_LOG_WORD_SIZE]; /**< Ring buffer.          */
+} PERCORE logs[CORES_NUM];
+
+/**
+ * @brief Binary record.
+ *
+ * The record is committed once its format string is set.
+ */
+struct hal_log_record
+{
+	uint32_t fmt;                       /**< Format string.   */
+	uint32_t timestamp;                 /**< Cycle counter.   */
+	uint32_t args[HAL_LOG_RECORD_ARGS]; /**< Argument words.  */
+};
+
+/**
+ * @brief Per-core binary log.
+ *
+ * Records have a fixed size, so reserving one is a single CAS on the
+ * free-running tail. The drain step releases a record by clearing its
+ * format string.
+ */
+PRIVATE struct hal_log_records
 {
-	size_t head;           /**< First element in the buffer.   */
-	size_t tail;            /**< Next free slot in the buffer. */
-	char buf[HAL_LOG_SIZE]; /**< Ring buffer.                  */
-} log = { 0, 0, {0, }};
+	uint32_t head;                                    /**< Next record to drain. */
+	uint32_t tail;                                    /**< Next free record.     */
+	uint32_t dropped;                                 /**< Dropped records.      */
+	struct hal_log_record records[HAL_LOG_RECORDS];   /**< Ring buffer.          */
+} PERCORE records[CORES_NUM];
+
+/**
+ * @brief Is the standard output device initialized?
+ */
+PRIVATE int hal_log_ready = FALSE;
+
+/**
+ * @brief Lock of the drain step.
+ */
+PRIVATE spinlock_t hal_log_lock = SPINLOCK_UNLOCKED;
 
 /*============================================================================*
- * hal_log_flush()                                                            *
+ * hal_log_reserve()                                                          *
  *============================================================================*/
 
 /**
- * @brief Flushes the HAL log buffer.
+ * @brief Reserves space in a HAL log.
  *
- * @author Pedro Henrique Penna
+ * @param log  Target log.
+ * @param size Number of bytes to reserve.
+ * @param pos  Location to store the position of the reserved space.
+ *
+ * @returns Upon successful completion, zero is returned. If there is
+ * not enough free space in the log, a negative number is returned
+ * instead.
  */
-PRIVATE void hal_log_flush(void)
+PRIVATE int hal_log_reserve(struct hal_log *log, uint32_t size, uint32_t *pos)
 {
-	ssize_t i;              /* Number of bytes to flush. */
-	char buf[KBUFFER_SIZE]; /* Temporary buffer.         */
-
-	/* No data, so nothing to do. */
-	if (log.head == log.tail)
-		return;
+	uint32_t head;
+	uint32_t tail;
 
-	/* Copy data from ring buffer. */
-	for (i = 0; i < KBUFFER_SIZE; /* noop */ )
+	do
 	{
-		buf[i] = log.buf[log.head];
+		tail = atomic_load(&log->tail);
+		head = atomic_load(&log->head);
 
-		i++;
-		log.head = (log.head + 1)%HAL_LOG_SIZE;
-		dcache_invalidate();
+		/* Not enough space. */
+		if ((tail - head + size) > HAL_LOG_SIZE)
+			return (-1);
+	} while (atomic_cas(&log->tail, tail, tail + size) != tail);
 
-		if (log.head == log.tail)
+	*pos = tail;
+
+	return (0);
+}
+
+/*============================================================================*
+ * hal_log_drain_core()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Drains the HAL log of a core.
+ *
+ * @param log Target log.
+ *
+ * Committed records are written to the standard output device in
+ * batches. Draining stops at the first record that is not yet
+ * committed.
+ */
+PRIVATE void hal_log_drain_core(struct hal_log *log)
+{
+	size_t n;                 /* Number of bytes in batch. */
+	uint32_t head;            /* Current record.           */
+	uint32_t hdr;             /* Header of current record. */
+	uint32_t size;            /* Size of current record.   */
+	const char *bytes;        /* Ring buffer.              */
+	char batch[KBUFFER_SIZE]; /* Batch of output.          */
+
+	n = 0;
+	bytes = (const char *) log->buf;
+	head = atomic_load(&log->head);
+
+	while (head != atomic_load(&log->tail))
+	{
+		hdr = atomic_load(&log->buf[HAL_LOG_OFFSET(head)/HAL_LOG_WORD_SIZE]);
+
+		/* Not committed yet. */
+		if (!(hdr & HAL_LOG_COMMITTED))
 			break;
+
+		hal_acquire();
+
+		/* Copy record to batch. */
+		for (uint32_t i = 0; i < (hdr & HAL_LOG_LENGTH); i++)
+		{
+			batch[n++] = bytes[HAL_LOG_OFFSET(head + HAL_LOG_WORD_SIZE + i)];
+
+			if (n == KBUFFER_SIZE)
+			{
+				stdout_write(batch, n);
+				n = 0;
+			}
+		}
+
+		/* Release record. */
+		size = HAL_LOG_RECORD_SIZE(hdr & HAL_LOG_LENGTH);
+		for (uint32_t i = 0; i < size; i += HAL_LOG_WORD_SIZE)
+			log->buf[HAL_LOG_OFFSET(head + i)/HAL_LOG_WORD_SIZE] = 0;
+		head += size;
+
+		hal_release();
+		atomic_store(&log->head, head);
 	}
 
-	stdout_write(buf, i);
+	if (n > 0)
+		stdout_write(batch, n);
+
+	/* Report dropped records. */
+	if (atomic_xchg(&log->dropped, 0) > 0)
+		stdout_write("[hal] log overrun\n", 18);
+}
+
+/*============================================================================*
+ * hal_log_format()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Formats a string.
+ *
+ * @param str  Output string.
+ * @param size Size of the output string.
+ * @param fmt  Format string.
+ *
+ * @returns The length of the output string.
+ */
+PRIVATE int hal_log_format(char *str, size_t size, const char *fmt, ...)
+{
+	int len;
+	va_list args;
+
+	va_start(args, fmt);
+	len = kvsnprintf(str, size, fmt, args);
+	va_end(args);
+
+	return (len);
+}
+
+/*============================================================================*
+ * hal_log_pop_record()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Pops a record from the binary log of a core.
+ *
+ * @param log    Target log.
+ * @param coreid ID of the core that owns the log.
+ * @param buf    Target buffer.
+ * @param size   Size of the target buffer.
+ *
+ * The oldest committed record is formatted, prefixed with the core
+ * ID and its timestamp, and written as a line to the buffer pointed
+ * to by @p buf.
+ *
+ * @returns The length of the line is returned. If there is no
+ * committed record, zero is returned instead.
+ */
+PRIVATE int hal_log_pop_record(struct hal_log_records *log, int coreid, char *buf, size_t size)
+{
+	int len;                          /* Length of line. */
+	uint32_t head;                    /* Current record. */
+	struct hal_log_record *record;    /* Current record. */
+
+	head = atomic_load(&log->head);
+
+	/* Empty log. */
+	if (head == atomic_load(&log->tail))
+		return (0);
+
+	record = &log->records[head & (HAL_LOG_RECORDS - 1)];
+
+	/* Not committed yet. */
+	if (atomic_load(&record->fmt) == 0)
+		return (0);
+
+	hal_acquire();
+
+	len = hal_log_format(buf, size,
+		"[core %d][%x] ",
+		coreid,
+		record->timestamp
+	);
+	len += hal_log_format(&buf[len], size - len - 1,
+		(const char *) record->fmt,
+		record->args[0],
+		record->args[1],
+		record->args[2],
+		record->args[3]
+	);
+	buf[len++] = '\n';
+
+	/* Release record. */
+	hal_release();
+	atomic_store(&record->fmt, 0);
+	atomic_store(&log->head, ++head);
+
+	return (len);
+}
+
+/*============================================================================*
+ * hal_log_drain_records()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Drains the binary log of a core.
+ *
+ * @param log    Target log.
+ * @param coreid ID of the core that owns the log.
+ *
+ * Committed records are written to the standard output device, as
+ * formatted by hal_log_pop_record(). Draining stops at the first
+ * record that is not yet committed.
+ */
+PRIVATE void hal_log_drain_records(struct hal_log_records *log, int coreid)
+{
+	int len;                   /* Length of line. */
+	char line[2*KBUFFER_SIZE]; /* Output line.    */
+
+	while ((len = hal_log_pop_record(log, coreid, line, sizeof(line))) > 0)
+		stdout_write(line, len);
+
+	/* Report dropped records. */
+	if (atomic_xchg(&log->dropped, 0) > 0)
+		stdout_write("[hal] log overrun\n", 18);
+}
+
+/*============================================================================*
+ * hal_log_drain()                                                            *
+ *============================================================================*/
+
+/**
+ * The hal_log_drain() function writes the committed records of all
+ * per-core HAL logs to the standard output device. If another core
+ * is already draining the logs, this function returns immediately.
+ *
+ * @note Text and binary logs are not merged: for each core, all text
+ * records are written before its binary records. Binary records are
+ * timestamped, but text records are not.
+ */
+PUBLIC void hal_log_drain(void)
+{
+	/* Standard output device not initialized. */
+	if (!hal_log_ready)
+		return;
+
+	/* Someone else is draining. */
+	if (!SPINLOCK_TRYLOCK_OK(spinlock_trylock(&hal_log_lock)))
+		return;
+
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		hal_log_drain_core(&logs[i]);
+		hal_log_drain_records(&records[i], i);
+	}
+
+	spinlock_unlock(&hal_log_lock);
 }
 
 /*============================================================================*
@@ -78,28 +371,123 @@ PRIVATE void hal_log_flush(void)
 
 /**
  * The hal_log_write() function writes @p n bytes of the buffer
- * pointed to by @p buf in the HAL log and in the standard output
- * device of the underlying target.
+ * pointed to by @p buf as a single record in the HAL log of the
+ * underlying core. The record is output later, as a whole, by
+ * hal_log_drain(). Records longer than HAL_LOG_RECORD_MAX bytes are
+ * truncated.
  *
- * @author Pedro Henrique Penna
+ * If the log is full, hal_log_drain() is called once to make room.
+ * If there is still no room, the record is dropped.
  *
- * @todo Make this thread safe.
+ * @author Pedro Henrique Penna
  */
 PUBLIC void hal_log_write(const char *buf, size_t n)
 {
-	/* Avoid race conditions. */
-	if (core_get_id() == COREID_MASTER)
+	uint32_t pos;
+	char *bytes;
+	struct hal_log *log = &logs[core_get_id()];
+
+	/* Nothing to do. */
+	if (n == 0)
+		return;
+
+	/* Truncate record. */
+	if (n > HAL_LOG_RECORD_MAX)
+		n = HAL_LOG_RECORD_MAX;
+
+	/* Reserve space. */
+	if (hal_log_reserve(log, HAL_LOG_RECORD_SIZE(n), &pos) < 0)
 	{
-		/* Copy data to ring buffer. */
-		for (size_t i = 0; i < n; i++)
+		hal_log_drain();
+
+		if (hal_log_reserve(log, HAL_LOG_RECORD_SIZE(n), &pos) < 0)
 		{
-			log.buf[log.tail] = buf[i];
-			log.tail = (log.tail + 1)%HAL_LOG_SIZE;
-			dcache_invalidate();
+			atomic_fetch_add(&log->dropped, 1);
+			return;
 		}
 	}
 
-	stdout_write(buf, n);
+	/* Copy record. */
+	bytes = (char *) log->buf;
+	for (size_t i = 0; i < n; i++)
+		bytes[HAL_LOG_OFFSET(pos + HAL_LOG_WORD_SIZE + i)] = buf[i];
+
+	/* Commit record. */
+	hal_release();
+	atomic_store(
+		&log->buf[HAL_LOG_OFFSET(pos)/HAL_LOG_WORD_SIZE],
+		HAL_LOG_COMMITTED | n
+	);
+}
+
+/*============================================================================*
+ * hal_log_record()                                                           *
+ *============================================================================*/
+
+/**
+ * The hal_log_record() function writes a binary record to the HAL log
+ * of the underlying core. The record holds the format string pointed
+ * to by @p fmt, HAL_LOG_RECORD_ARGS argument words taken from @p args
+ * and the low-order bits of the cycle counter. If the log is full,
+ * the record is dropped.
+ */
+PUBLIC void hal_log_record(const char *fmt, const uint32_t *args)
+{
+	uint32_t tail;
+	struct hal_log_record *record;
+	struct hal_log_records *log = &records[core_get_id()];
+
+	/* Reserve record. */
+	do
+	{
+		tail = atomic_load(&log->tail);
+
+		/* Log is full. */
+		if ((tail - atomic_load(&log->head)) >= HAL_LOG_RECORDS)
+		{
+			atomic_fetch_add(&log->dropped, 1);
+			return;
+		}
+	} while (atomic_cas(&log->tail, tail, tail + 1) != tail);
+
+	record = &log->records[tail & (HAL_LOG_RECORDS - 1)];
+
+	record->timestamp = (uint32_t) clock_read_cycles();
+	for (int i = 0; i < HAL_LOG_RECORD_ARGS; i++)
+		record->args[i] = args[i];
+
+	/* Commit record. */
+	hal_release();
+	atomic_store(&record->fmt, (uint32_t) fmt);
+}
+
+/*============================================================================*
+ * hal_log_read()                                                             *
+ *============================================================================*/
+
+/**
+ * The hal_log_read() function pops the oldest committed binary record
+ * of the underlying core, and writes it to the buffer pointed to by
+ * @p buf, formatted as hal_log_drain() would output it. At most
+ * @p size bytes are written, and the line is not null terminated.
+ *
+ * @returns Upon successful completion, the length of the line is
+ * returned. If there is no committed record, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PUBLIC int hal_log_read(char *buf, size_t size)
+{
+	int len;
+
+	/* Invalid buffer. */
+	if ((buf == NULL) || (size < 2))
+		return (-EINVAL);
+
+	spinlock_lock(&hal_log_lock);
+		len = hal_log_pop_record(&records[core_get_id()], core_get_id(), buf, size);
+	spinlock_unlock(&hal_log_lock);
+
+	return (len);
 }
 
 /*============================================================================*
@@ -117,5 +505,8 @@ PUBLIC void hal_log_setup(void)
 {
 	stdout_init();
 
-	hal_log_flush();
+	hal_log_ready = TRUE;
+	hal_wmb();
+
+	hal_log_drain();
 }
@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#include <nanvix/hal/hal.h>
 #include <nanvix/hal/resource.h>
 #include <nanvix/const.h>
 
@@ -90,6 +91,113 @@ PRIVATE void resource_dumb_free(const struct resource_pool *pool, int id)
 	resource_set_unused(resource);
 }
 
+/*============================================================================*
+ * resource_bitmap_alloc()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Bitmap resource allocator.
+ *
+ * @param pool Target generic resource pool.
+ *
+ * @returns Upon successful completion, the ID of a newly allocated
+ * resource point is returned. Upon failure, -1 is returned instead.
+ *
+ * The search starts at the bitmap word pointed to by the pool hint.
+ * Within a word, the first free bit is found with bit_ctz() and
+ * claimed with a compare-and-swap, which is retried if another core
+ * changed the word in the meantime. Pools without a bitmap are
+ * handed to resource_dumb_alloc().
+ *
+ * @note This function is non-blocking.
+ * @note This function is thread safe.
+ * @note This function is reentrant.
+ */
+PRIVATE int resource_bitmap_alloc(const struct resource_pool *pool)
+{
+	int n = pool->nresources;
+	int nwords = RESOURCE_BITMAP_LENGTH(n);
+	int w;
+
+	/* No bitmap. */
+	if (pool->bitmap == NULL)
+		return (resource_dumb_alloc(pool));
+
+	w = atomic_load(pool->hint);
+
+	for (int i = 0; i < nwords; i++, w++)
+	{
+		uint32_t word;
+
+		/* Wrap around. */
+		if (w >= nwords)
+			w = 0;
+
+		word = atomic_load(&pool->bitmap[w]);
+
+		while (word != 0xffffffff)
+		{
+			int id;
+			int bit;
+			uint32_t old;
+
+			bit = bit_ctz(~word);
+			id = (w << 5) + bit;
+
+			/* Past the last resource. */
+			if (id >= n)
+				break;
+
+			old = atomic_cas(&pool->bitmap[w], word, word | (1U << bit));
+
+			/* Found. */
+			if (old == word)
+			{
+				char *base = (char *) pool->resources;
+
+				atomic_store(pool->hint, w);
+				resource_set_used((struct resource *)(&base[id*pool->resource_size]));
+
+				return (id);
+			}
+
+			word = old;
+		}
+	}
+
+	return (-1);
+}
+
+/*============================================================================*
+ * resource_bitmap_free()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Bitmap resource releaser.
+ *
+ * @param pool Target generic resource pool.
+ * @param id   ID of the target resource.
+ *
+ * The resource is marked as not used before its bit is cleared, so
+ * that it is never handed out while still flagged. The pool hint is
+ * moved to the released word, as it now has a free slot.
+ *
+ * @note This function is non-blocking.
+ * @note This function is thread safe.
+ * @note This function is reentrant.
+ */
+PRIVATE void resource_bitmap_free(const struct resource_pool *pool, int id)
+{
+	resource_dumb_free(pool, id);
+
+	/* No bitmap. */
+	if (pool->bitmap == NULL)
+		return;
+
+	atomic_fetch_and(&pool->bitmap[id >> 5], ~(1U << (id & 31)));
+	atomic_store(pool->hint, id >> 5);
+}
+
 /*============================================================================*
  * Resource Allocator                                                         *
  *============================================================================*/
@@ -97,9 +205,9 @@ PRIVATE void resource_dumb_free(const struct resource_pool *pool, int id)
 /**
  * @brief Default resource allocator.
  */
-alloc_fn resource_alloc = resource_dumb_alloc;
+alloc_fn resource_alloc = resource_bitmap_alloc;
 
 /**
  * @brief Default resource de-allocator.
  */
-free_fn resource_free = resource_dumb_free;
+free_fn resource_free = resource_bitmap_free;
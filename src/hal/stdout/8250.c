@@ -22,13 +22,20 @@
  * SOFTWARE.
  */
 
+#include <nanvix/hal/hal.h>
 #include <arch/stdout/8250.h>
 #include <nanvix/const.h>
+#include <errno.h>
+
+/* Transmit ring size should be a power of two. */
+#if (UART_TXBUF_SIZE & (UART_TXBUF_SIZE - 1))
+#error "UART_TXBUF_SIZE should be a power of two"
+#endif
 
 /**
  * @brief uart8250 memory.
  */
-PRIVATE uint8_t *uart8250 = (uint8_t*)UART_ADDR;
+PRIVATE volatile uint8_t *uart8250 = (volatile uint8_t*)UART_ADDR;
 
 /**
  * @brief Flag that indicates if the device was initialized.
@@ -36,13 +43,86 @@ PRIVATE uint8_t *uart8250 = (uint8_t*)UART_ADDR;
 PRIVATE int uart8250_initialized = 0;
 
 /**
- * Writes into serial port.
- * @param c Data to be written.
+ * @brief Flag that indicates if interrupt-driven transmission is on.
+ */
+PRIVATE int uart8250_irq_enabled = 0;
+
+/**
+ * @brief Transmit ring.
+ */
+PRIVATE struct
+{
+	unsigned head;              /**< Next byte to send.   */
+	unsigned tail;              /**< Next free slot.      */
+	char buf[UART_TXBUF_SIZE];  /**< Pending bytes.       */
+	spinlock_t lock;            /**< Ring lock.           */
+} txring = {
+	.head = 0,
+	.tail = 0,
+	.lock = SPINLOCK_UNLOCKED
+};
+
+/**
+ * @brief Moves pending bytes from the transmit ring to the device.
+ *
+ * If the transmitter FIFO is empty, up to UART_FIFO_SIZE bytes are
+ * written to it at once. Otherwise, this function returns
+ * immediately.
+ *
+ * @note The transmit ring lock should be held.
+ */
+PRIVATE void uart8250_push(void)
+{
+	/* Transmitter is busy. */
+	if (!(uart8250[LSR] & LSR_TFE))
+		return;
+
+	for (int i = 0; (i < UART_FIFO_SIZE) && (txring.head != txring.tail); i++)
+		uart8250[THR] = txring.buf[txring.head++ & (UART_TXBUF_SIZE - 1)];
+}
+
+/**
+ * @brief Handles the Transmitter Holding Register Empty interrupt.
+ *
+ * @param num Number of the triggered interrupt.
+ */
+PRIVATE void uart8250_handler(int num)
+{
+	uint8_t iir;
+
+	UNUSED(num);
+
+	/* Acknowledge interrupt. */
+	iir = uart8250[IIR];
+	UNUSED(iir);
+
+	/*
+	 * The ring is busy. Its holder either drains
+	 * it or rearms this interrupt once it is done.
+	 */
+	if (!SPINLOCK_TRYLOCK_OK(spinlock_trylock(&txring.lock)))
+		return;
+
+	uart8250_push();
+
+	/* Nothing else to send. */
+	if (txring.head == txring.tail)
+		uart8250[IER] = 0;
+
+	spinlock_unlock(&txring.lock);
+}
+
+/**
+ * The uart8250_write() function enqueues @p n bytes of the buffer
+ * pointed to by @p buf in the transmit ring of the 8250 device. In
+ * interrupt-driven mode, this function pushes a first burst to the
+ * device and returns as soon as all bytes are enqueued, blocking
+ * only when the ring is full. Otherwise, the ring is drained before
+ * the function returns, filling the transmitter FIFO in bursts.
  */
 PUBLIC void uart8250_write(const char *buf, size_t n)
 {
-	size_t counter;
-	counter = 0;
+	int pending;
 
 	/**
 	 * It's important to only try to write if the device
@@ -51,19 +131,91 @@ PUBLIC void uart8250_write(const char *buf, size_t n)
 	if (!uart8250_initialized)
 		return;
 
-	while (n)
-	{
-		/* Wait until FIFO is empty. */
-		while ( !(uart8250[LSR] & LSR_TFE) );
+	spinlock_lock(&txring.lock);
+
+		while (n > 0)
+		{
+			/* Ring is full. */
+			if ((txring.tail - txring.head) == UART_TXBUF_SIZE)
+			{
+				uart8250_push();
+				continue;
+			}
+
+			txring.buf[txring.tail++ & (UART_TXBUF_SIZE - 1)] = *buf++;
+			n--;
+		}
 
-		/* Write character to device. */
-		uart8250[THR] = buf[counter];
+		/* Drain the ring. */
+		if (!uart8250_irq_enabled)
+		{
+			while (txring.head != txring.tail)
+				uart8250_push();
+		}
 
-		n--;
-		counter++;
+		/* Push a first burst. */
+		else
+			uart8250_push();
+
+		pending = (txring.head != txring.tail);
+
+	spinlock_unlock(&txring.lock);
+
+	/*
+	 * Let the device interrupt us when it is ready. This is
+	 * done after releasing the ring, otherwise the handler could
+	 * not push it. Toggling the enable bit raises the interrupt
+	 * again, in case the handler gave up on a busy ring.
+	 */
+	if (pending)
+	{
+		uart8250[IER] = 0;
+		uart8250[IER] = (1 << IER_TEI);
 	}
 }
 
+/**
+ * The uart8250_flush() function blocks until all bytes in the
+ * transmit ring of the 8250 device are handed to the device. It is
+ * intended for contexts in which interrupts may not be delivered,
+ * such as kernel panic.
+ */
+PUBLIC void uart8250_flush(void)
+{
+	if (!uart8250_initialized)
+		return;
+
+	spinlock_lock(&txring.lock);
+
+		while (txring.head != txring.tail)
+			uart8250_push();
+
+	spinlock_unlock(&txring.lock);
+}
+
+/**
+ * The uart8250_irq_setup() function switches the 8250 device to
+ * interrupt-driven transmission. It should be called after the
+ * interrupt system is initialized.
+ *
+ * @see stdout_irq_setup().
+ */
+PUBLIC int uart8250_irq_setup(void)
+{
+	int ret;
+
+	if (!uart8250_initialized)
+		return (-EAGAIN);
+
+	if ((ret = interrupt_register(UART_IRQ, uart8250_handler)) < 0)
+		return (ret);
+
+	uart8250_irq_enabled = 1;
+	interrupt_unmask(UART_IRQ);
+
+	return (0);
+}
+
 /**
  * Initializes the serial device.
  */
@@ -90,7 +242,7 @@ PUBLIC void uart8250_init(void)
 	/* Reset FIFOs and set trigger level to 1 byte. */
 	uart8250[FCR] = FCR_CLRRECV | FCR_CLRTMIT | FCR_TRIG_1;
 
-	/* Disable 'Data Available Interrupt'. */
+	/* Disable all interrupts until there is something to send. */
 	uart8250[IER] = 0;
 
 	/* Device initialized. */
@@ -25,6 +25,7 @@
 #include <nanvix/hal/hal.h>
 #include <arch/stdout/console.h>
 #include <nanvix/const.h>
+#include <nanvix/klib.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -60,19 +61,25 @@ PRIVATE void cursor_move(void)
 /**
  * @brief Scrolls down the console.
  *
- * Scrolls down the console by one row.
+ * Scrolls down the console by one row. Lines are pulled up with a
+ * single word-wide move, and the last line is blanked two cells at a
+ * time.
  */
 PRIVATE void console_scrolldown(void)
 {
-	uint16_t *p;
+	uint32_t *p;
+	const uint32_t blank = ((BLACK << 8) | (' ')) * 0x00010001;
 
 	/* Pull lines up. */
-	for (p = video; p < (video + (VIDEO_HIGH-1)*(VIDEO_WIDTH)); p++)
-		*p = *(p + VIDEO_WIDTH);
+	kmemmove(video,
+		video + VIDEO_WIDTH,
+		(VIDEO_HIGH - 1)*VIDEO_WIDTH*sizeof(uint16_t)
+	);
 
 	/* Blank last line. */
-	for (; p < video + VIDEO_HIGH*VIDEO_WIDTH; p++)
-		*p = (BLACK << 8) | (' ');
+	p = (uint32_t *)(video + (VIDEO_HIGH - 1)*VIDEO_WIDTH);
+	for (int i = 0; i < VIDEO_WIDTH/2; i++)
+		p[i] = blank;
 
 	/* Set cursor position. */
 	cursor.x = 0; cursor.y = VIDEO_HIGH - 1;
@@ -130,7 +137,6 @@ PRIVATE void console_put(uint8_t ch, uint8_t color)
     }
     if (cursor.y >= VIDEO_HIGH)
         console_scrolldown();
-    cursor_move();
 }
 
 /**
@@ -151,12 +157,16 @@ PRIVATE void console_clear(void)
 
 /**
  * The console_write() function writes @p n bytes of the data buffer
- * pointer to by @p buf to the console device.
+ * pointer to by @p buf to the console device. The whole buffer is
+ * rendered into video memory first, and the hardware cursor is
+ * updated only once at the end.
  */
 PUBLIC void console_write(const char *buf, size_t n)
 {
 	for (size_t i = 0; i < n; i++)
 		console_put((uint8_t) buf[i], WHITE);
+
+	cursor_move();
 }
 
 /**
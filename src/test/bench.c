@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/klib.h>
+#include "test.h"
+
+/**
+ * @brief Sorts samples in ascending order.
+ *
+ * @param samples Target samples.
+ * @param n       Number of samples.
+ */
+PRIVATE void bench_sort(unsigned *samples, int n)
+{
+	for (int i = 1; i < n; i++)
+	{
+		unsigned x = samples[i];
+		int j;
+
+		for (j = i - 1; (j >= 0) && (samples[j] > x); j--)
+			samples[j + 1] = samples[j];
+
+		samples[j + 1] = x;
+	}
+}
+
+/**
+ * The bench_report() function prints the results of the benchmark
+ * named @p name, whose @p n samples are stored in @p samples. Results
+ * are printed in a single line, in the following format:
+ *
+ *   [bench] <name> <iterations> <min> <median> <max>
+ *
+ * where figures are given in cycles. Samples are sorted in place.
+ */
+PUBLIC void bench_report(const char *name, unsigned *samples, int n)
+{
+	/* Nothing to report. */
+	if (n <= 0)
+		return;
+
+	bench_sort(samples, n);
+
+	kprintf("[bench] %s %d %u %u %u",
+		name,
+		n,
+		samples[0],
+		samples[n/2],
+		samples[n - 1]
+	);
+}
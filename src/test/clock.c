@@ -50,6 +50,48 @@ PRIVATE void do_clock(int num)
 	dcache_invalidate();
 }
 
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Read Cycle Counter
+ */
+PRIVATE void test_clock_read_cycles(void)
+{
+	uint64_t t0, t1;
+
+	KASSERT(clock_cycles_freq() > 0);
+
+	t0 = clock_read_cycles();
+
+		/* Wait for the counter to advance. */
+		do
+		{
+			noop();
+			t1 = clock_read_cycles();
+			KASSERT(t1 >= t0);
+		} while (t1 == t0);
+}
+
+/**
+ * @brief API Test: Read Monotonic Timestamp
+ */
+PRIVATE void test_clock_read_ns(void)
+{
+	uint64_t t0, t1;
+
+	t0 = clock_read_ns();
+
+		/* Wait for the timestamp to advance. */
+		do
+		{
+			noop();
+			t1 = clock_read_ns();
+			KASSERT(t1 >= t0);
+		} while (t1 == t0);
+}
+
 /*============================================================================*
  * Stress Tests                                                               *
  *============================================================================*/
@@ -84,6 +126,15 @@ PRIVATE void test_do_clock(void)
  * Test Driver                                                                *
  *============================================================================*/
 
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test clock_api_tests[] = {
+	{ test_clock_read_cycles, "Read Cycle Counter"        },
+	{ test_clock_read_ns,     "Read Monotonic Timestamp"  },
+	{ NULL,                   NULL                        },
+};
+
 /**
  * @brief Unit tests.
  */
@@ -100,6 +151,12 @@ PRIVATE struct test clock_stress_tests[] = {
  */
 PUBLIC void test_clock(void)
 {
+	for (int i = 0; clock_api_tests[i].test_fn != NULL; i++)
+	{
+		clock_api_tests[i].test_fn();
+		kprintf("[test][api][clock] %s [passed]", clock_api_tests[i].name);
+	}
+
 	for (int i = 0; clock_stress_tests[i].test_fn != NULL; i++)
 	{
 		clock_stress_tests[i].test_fn();
@@ -215,6 +215,229 @@ PRIVATE void test_core_suspend_resume_master(void)
 	}
 }
 
+/*----------------------------------------------------------------------------*
+ * Fair Spinlocks                                                             *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Number of increments per core.
+ */
+#define TEST_CORE_NLOCKS 256
+
+/**
+ * @brief API Test: Ticket lock.
+ */
+PRIVATE ticketlock_t test_ticketlock;
+
+/**
+ * @brief API Test: Queue spinlock.
+ */
+PRIVATE qspinlock_t test_qspinlock;
+
+/**
+ * @brief API Test: Counter protected by fair spinlocks.
+ */
+PRIVATE volatile int test_lock_counter = 0;
+
+/**
+ * @brief API Test: Number of cores that are done.
+ */
+PRIVATE volatile int test_lock_done = 0;
+
+/**
+ * @brief API Test: Increments the shared counter.
+ */
+PRIVATE void test_core_lock_increment(void)
+{
+	for (int i = 0; i < TEST_CORE_NLOCKS; i++)
+	{
+		ticketlock_lock(&test_ticketlock);
+			test_lock_counter++;
+		ticketlock_unlock(&test_ticketlock);
+
+		qspinlock_lock(&test_qspinlock);
+			test_lock_counter++;
+		qspinlock_unlock(&test_qspinlock);
+	}
+
+	ticketlock_lock(&test_ticketlock);
+		test_lock_done++;
+	ticketlock_unlock(&test_ticketlock);
+}
+
+/**
+ * @brief API Test: Has the slave core started?
+ */
+PRIVATE volatile int test_lock_started = 0;
+
+/**
+ * @brief API Test: Function run by the slave core.
+ */
+PRIVATE void (*test_lock_worker)(void) = NULL;
+
+/**
+ * @brief API Test: Slave Core, Lock Tests entry point.
+ */
+PRIVATE void test_core_lock_slave_entry(void)
+{
+	test_lock_started = 1;
+	dcache_invalidate();
+
+	test_lock_worker();
+}
+
+/**
+ * @brief API Test: Runs a lock test.
+ *
+ * @param worker Function to run in the master and in one slave core,
+ * if any. It should increment test_lock_done when done.
+ *
+ * @returns The number of cores that ran @p worker.
+ */
+PRIVATE int test_core_lock_run(void (*worker)(void))
+{
+	int ncores = 1;
+
+	test_lock_done = 0;
+	test_lock_started = 0;
+	test_lock_worker = worker;
+	dcache_invalidate();
+
+	/*
+	 * Start one slave core. It may still be
+	 * finishing a previous test, so retry.
+	 */
+	if (CLUSTER_IS_MULTICORE)
+	{
+		for (int i = 0; i < CORES_NUM; i++)
+		{
+			if (i != COREID_MASTER)
+			{
+				do
+				{
+					core_start(i, test_core_lock_slave_entry);
+					dcache_invalidate();
+				} while (!test_lock_started);
+
+				ncores++;
+				break;
+			}
+		}
+	}
+
+	worker();
+
+	while (test_lock_done != ncores)
+		dcache_invalidate();
+
+	return (ncores);
+}
+
+/**
+ * @brief API Test: Ticket and Queue Spinlocks
+ *
+ * The master and one slave core, if any, increment a shared counter
+ * under ticket and queue spinlocks. No update should be lost.
+ */
+PRIVATE void test_core_fair_spinlocks(void)
+{
+	int ncores;
+
+	ticketlock_init(&test_ticketlock);
+	qspinlock_init(&test_qspinlock);
+
+	ncores = test_core_lock_run(test_core_lock_increment);
+
+	KASSERT(test_lock_counter == 2*TEST_CORE_NLOCKS*ncores);
+}
+
+/*----------------------------------------------------------------------------*
+ * Reader-Writer and Sequence Locks                                           *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Reader-writer spinlock.
+ */
+PRIVATE rwlock_t test_rwlock;
+
+/**
+ * @brief API Test: Sequence lock.
+ */
+PRIVATE seqlock_t test_seqlock;
+
+/**
+ * @brief API Test: Data protected by reader-writer and sequence locks.
+ */
+PRIVATE volatile struct
+{
+	int a; /**< Must equal b. */
+	int b; /**< Must equal a. */
+} test_rw_data[2];
+
+/**
+ * @brief API Test: Reads and updates shared data.
+ */
+PRIVATE void test_core_rw_worker(void)
+{
+	for (int i = 0; i < TEST_CORE_NLOCKS; i++)
+	{
+		int a, b;
+		uint32_t seq;
+
+		/* Update once in a while. */
+		if ((i & 7) == 0)
+		{
+			rwlock_write_lock(&test_rwlock);
+				test_rw_data[0].a++;
+				test_rw_data[0].b++;
+			rwlock_write_unlock(&test_rwlock);
+
+			seqlock_write_lock(&test_seqlock);
+				test_rw_data[1].a++;
+				test_rw_data[1].b++;
+			seqlock_write_unlock(&test_seqlock);
+		}
+
+		rwlock_read_lock(&test_rwlock);
+			KASSERT(test_rw_data[0].a == test_rw_data[0].b);
+		rwlock_read_unlock(&test_rwlock);
+
+		do
+		{
+			seq = seqlock_read_begin(&test_seqlock);
+				a = test_rw_data[1].a;
+				b = test_rw_data[1].b;
+		} while (seqlock_read_retry(&test_seqlock, seq));
+
+		KASSERT(a == b);
+	}
+
+	ticketlock_lock(&test_ticketlock);
+		test_lock_done++;
+	ticketlock_unlock(&test_ticketlock);
+}
+
+/**
+ * @brief API Test: Reader-Writer and Sequence Locks
+ *
+ * The master and one slave core, if any, read and update shared data
+ * under reader-writer and sequence locks. No torn read should be seen
+ * and no update should be lost.
+ */
+PRIVATE void test_core_rw_locks(void)
+{
+	int ncores;
+
+	ticketlock_init(&test_ticketlock);
+	rwlock_init(&test_rwlock);
+	seqlock_init(&test_seqlock);
+
+	ncores = test_core_lock_run(test_core_rw_worker);
+
+	KASSERT(test_rw_data[0].a == (TEST_CORE_NLOCKS/8)*ncores);
+	KASSERT(test_rw_data[1].a == (TEST_CORE_NLOCKS/8)*ncores);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -223,10 +446,12 @@ PRIVATE void test_core_suspend_resume_master(void)
  * @brief Unit tests.
  */
 PRIVATE struct test core_tests_api[] = {
-	{ test_core_get_id,                "Get Core ID"                    },
-	{ test_core_start_slave,           "Start Execution Slave"          },
-	{ test_core_suspend_resume_master, "Suspend and Resume from Master" },
-	{ NULL,                            NULL                             },
+	{ test_core_get_id,                "Get Core ID"                      },
+	{ test_core_start_slave,           "Start Execution Slave"            },
+	{ test_core_suspend_resume_master, "Suspend and Resume from Master"   },
+	{ test_core_fair_spinlocks,        "Ticket and Queue Spinlocks"       },
+	{ test_core_rw_locks,              "Reader-Writer and Sequence Locks" },
+	{ NULL,                            NULL                               },
 };
 
 /**
@@ -244,3 +469,618 @@ PUBLIC void test_core(void)
 		kprintf("[test][api][core] %s [passed]", core_tests_api[i].name);
 	}
 }
+
+/*============================================================================*
+ * Benchmarks                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Spinlock used in benchmarks.
+ */
+PRIVATE spinlock_t bench_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Benchmark: Number of times that the slave core was started.
+ */
+PRIVATE int bench_core_started = 0;
+
+/**
+ * @brief Benchmark: Iteration reached by the slave core after a wakeup.
+ */
+PRIVATE int bench_core_awaken = 0;
+
+/**
+ * @brief Benchmark: Lock and Unlock a Spinlock
+ */
+PRIVATE void bench_core_spinlock(void)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			spinlock_lock(&bench_lock);
+			spinlock_unlock(&bench_lock);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("spinlock-lock-unlock", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Lock and Unlock a Ticket Lock
+ */
+PRIVATE void bench_core_ticketlock(void)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+	ticketlock_t lock;
+
+	ticketlock_init(&lock);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			ticketlock_lock(&lock);
+			ticketlock_unlock(&lock);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("ticketlock-lock-unlock", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Lock and Unlock a Queue Spinlock
+ */
+PRIVATE void bench_core_qspinlock(void)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+	qspinlock_t lock;
+
+	qspinlock_init(&lock);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			qspinlock_lock(&lock);
+			qspinlock_unlock(&lock);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("qspinlock-lock-unlock", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Operations on a lock under contention.
+ */
+PRIVATE struct
+{
+	const char *name;         /**< Name of the benchmark. */
+	void (*lock)(void *);     /**< Lock function.         */
+	void (*unlock)(void *);   /**< Unlock function.       */
+	void *obj;                /**< Target lock.           */
+} bench_contended;
+
+/**
+ * @brief Benchmark: Contention state.
+ */
+PRIVATE volatile int bench_contended_state = 0;
+
+/**
+ * @name Benchmark: Contention states.
+ */
+/**@{*/
+#define BENCH_CONTENDED_IDLE    0 /**< Slave not running.  */
+#define BENCH_CONTENDED_RUNNING 1 /**< Slave running.      */
+#define BENCH_CONTENDED_STOP    2 /**< Slave should stop.  */
+/**@}*/
+
+/**
+ * @name Benchmark: Contended locks.
+ */
+/**@{*/
+PRIVATE spinlock_t bench_contended_spinlock;
+PRIVATE ticketlock_t bench_contended_ticketlock;
+PRIVATE qspinlock_t bench_contended_qspinlock;
+/**@}*/
+
+/**
+ * @name Benchmark: Lock wrappers.
+ */
+/**@{*/
+PRIVATE void bench_spinlock_lock(void *l) { spinlock_lock(l); }
+PRIVATE void bench_spinlock_unlock(void *l) { spinlock_unlock(l); }
+PRIVATE void bench_ticketlock_lock(void *l) { ticketlock_lock(l); }
+PRIVATE void bench_ticketlock_unlock(void *l) { ticketlock_unlock(l); }
+PRIVATE void bench_qspinlock_lock(void *l) { qspinlock_lock(l); }
+PRIVATE void bench_qspinlock_unlock(void *l) { qspinlock_unlock(l); }
+/**@}*/
+
+/**
+ * @brief Benchmark: Slave Core, Contended Lock entry point.
+ */
+PRIVATE void bench_core_contended_slave_entry(void)
+{
+	bench_contended_state = BENCH_CONTENDED_RUNNING;
+	dcache_invalidate();
+
+	while (bench_contended_state != BENCH_CONTENDED_STOP)
+	{
+		bench_contended.lock(bench_contended.obj);
+		bench_contended.unlock(bench_contended.obj);
+	}
+
+	bench_contended_state = BENCH_CONTENDED_IDLE;
+	dcache_invalidate();
+}
+
+/**
+ * @brief Benchmark: Lock and Unlock under Contention
+ *
+ * Measures lock-unlock pairs in the master core, while a slave core
+ * hammers the same lock.
+ */
+PRIVATE void bench_core_contended(int coreid)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	bench_contended_state = BENCH_CONTENDED_IDLE;
+	dcache_invalidate();
+
+	do
+	{
+		core_start(coreid, bench_core_contended_slave_entry);
+		dcache_invalidate();
+	} while (bench_contended_state != BENCH_CONTENDED_RUNNING);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			bench_contended.lock(bench_contended.obj);
+			bench_contended.unlock(bench_contended.obj);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	/* Wait for the slave to stop. */
+	bench_contended_state = BENCH_CONTENDED_STOP;
+	dcache_invalidate();
+	while (bench_contended_state != BENCH_CONTENDED_IDLE)
+		dcache_invalidate();
+
+	bench_report(bench_contended.name, samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Contended Spinlocks
+ */
+PRIVATE void bench_core_contended_locks(int coreid)
+{
+	spinlock_init(&bench_contended_spinlock);
+	ticketlock_init(&bench_contended_ticketlock);
+	qspinlock_init(&bench_contended_qspinlock);
+
+	bench_contended.name = "spinlock-contended";
+	bench_contended.lock = bench_spinlock_lock;
+	bench_contended.unlock = bench_spinlock_unlock;
+	bench_contended.obj = &bench_contended_spinlock;
+	bench_core_contended(coreid);
+
+	bench_contended.name = "ticketlock-contended";
+	bench_contended.lock = bench_ticketlock_lock;
+	bench_contended.unlock = bench_ticketlock_unlock;
+	bench_contended.obj = &bench_contended_ticketlock;
+	bench_core_contended(coreid);
+
+	bench_contended.name = "qspinlock-contended";
+	bench_contended.lock = bench_qspinlock_lock;
+	bench_contended.unlock = bench_qspinlock_unlock;
+	bench_contended.obj = &bench_contended_qspinlock;
+	bench_core_contended(coreid);
+}
+
+/**
+ * @brief Benchmark: Number of operations per sample in read-mostly
+ * benchmarks. One in every 64 operations is a write.
+ */
+#define BENCH_RM_BATCH 64
+
+/**
+ * @brief Benchmark: Read-mostly data.
+ */
+PRIVATE volatile struct
+{
+	unsigned a; /**< First field.  */
+	unsigned b; /**< Second field. */
+} bench_rm_data;
+
+/**
+ * @brief Benchmark: Sink for read-mostly data.
+ */
+PRIVATE volatile unsigned bench_rm_sink;
+
+/**
+ * @name Benchmark: Locks for read-mostly data.
+ */
+/**@{*/
+PRIVATE spinlock_t bench_rm_spinlock;
+PRIVATE rwlock_t bench_rm_rwlock;
+PRIVATE seqlock_t bench_rm_seqlock;
+/**@}*/
+
+/**
+ * @brief Benchmark: Operation on read-mostly data.
+ */
+PRIVATE void (*bench_rm_op)(int) = NULL;
+
+/**
+ * @brief Benchmark: Number of slave cores running.
+ */
+PRIVATE volatile int bench_rm_running = 0;
+
+/**
+ * @brief Benchmark: Should slave cores stop?
+ */
+PRIVATE volatile int bench_rm_stop = 0;
+
+/**
+ * @brief Benchmark: Read-mostly operation under a spinlock.
+ *
+ * @param i Operation number.
+ */
+PRIVATE void bench_rm_spinlock_op(int i)
+{
+	spinlock_lock(&bench_rm_spinlock);
+
+		if ((i % BENCH_RM_BATCH) == 0)
+		{
+			bench_rm_data.a++;
+			bench_rm_data.b++;
+		}
+		else
+			bench_rm_sink = bench_rm_data.a + bench_rm_data.b;
+
+	spinlock_unlock(&bench_rm_spinlock);
+}
+
+/**
+ * @brief Benchmark: Read-mostly operation under a reader-writer
+ * spinlock.
+ *
+ * @param i Operation number.
+ */
+PRIVATE void bench_rm_rwlock_op(int i)
+{
+	if ((i % BENCH_RM_BATCH) == 0)
+	{
+		rwlock_write_lock(&bench_rm_rwlock);
+			bench_rm_data.a++;
+			bench_rm_data.b++;
+		rwlock_write_unlock(&bench_rm_rwlock);
+	}
+	else
+	{
+		rwlock_read_lock(&bench_rm_rwlock);
+			bench_rm_sink = bench_rm_data.a + bench_rm_data.b;
+		rwlock_read_unlock(&bench_rm_rwlock);
+	}
+}
+
+/**
+ * @brief Benchmark: Read-mostly operation under a sequence lock.
+ *
+ * @param i Operation number.
+ */
+PRIVATE void bench_rm_seqlock_op(int i)
+{
+	uint32_t seq;
+	unsigned x;
+
+	if ((i % BENCH_RM_BATCH) == 0)
+	{
+		seqlock_write_lock(&bench_rm_seqlock);
+			bench_rm_data.a++;
+			bench_rm_data.b++;
+		seqlock_write_unlock(&bench_rm_seqlock);
+	}
+	else
+	{
+		do
+		{
+			seq = seqlock_read_begin(&bench_rm_seqlock);
+				x = bench_rm_data.a + bench_rm_data.b;
+		} while (seqlock_read_retry(&bench_rm_seqlock, seq));
+
+		bench_rm_sink = x;
+	}
+}
+
+/**
+ * @brief Benchmark: Slave Core, Read-Mostly entry point.
+ */
+PRIVATE void bench_core_rm_slave_entry(void)
+{
+	spinlock_lock(&bench_lock);
+		bench_rm_running++;
+	spinlock_unlock(&bench_lock);
+
+	for (int i = 1; !bench_rm_stop; i++)
+		bench_rm_op(i);
+
+	spinlock_lock(&bench_lock);
+		bench_rm_running--;
+	spinlock_unlock(&bench_lock);
+}
+
+/**
+ * @brief Benchmark: Read-Mostly Data
+ *
+ * Measures batches of operations on read-mostly data in the master
+ * core, while @p ncores - 1 slave cores run the same workload.
+ * Comparing results for different number of cores shows how well
+ * each lock scales.
+ *
+ * @param prefix Name prefix of the benchmark.
+ * @param op     Operation on read-mostly data.
+ * @param ncores Number of cores.
+ */
+PRIVATE void bench_core_read_mostly(const char *prefix, void (*op)(int), int ncores)
+{
+	size_t len;
+	char name[32];
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	bench_rm_op = op;
+	bench_rm_stop = 0;
+	bench_rm_running = 0;
+	dcache_invalidate();
+
+	/* Start slave cores. */
+	for (int i = 0, n = 1; (i < CORES_NUM) && (n < ncores); i++)
+	{
+		if (i == COREID_MASTER)
+			continue;
+
+		do
+		{
+			core_start(i, bench_core_rm_slave_entry);
+			dcache_invalidate();
+		} while (bench_rm_running < n);
+
+		n++;
+	}
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			for (int j = 0; j < BENCH_RM_BATCH; j++)
+				op(j);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	/* Wait for slave cores to stop. */
+	bench_rm_stop = 1;
+	dcache_invalidate();
+	while (bench_rm_running > 0)
+		dcache_invalidate();
+
+	/* Build name: <prefix>-<ncores>. */
+	len = kstrlen(prefix);
+	kstrcpy(name, prefix);
+	name[len] = '-';
+	name[len + 1] = '0' + (ncores / 10);
+	name[len + 2] = '0' + (ncores % 10);
+	name[len + 3] = '\0';
+
+	bench_report(name, samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Read-Mostly Data, Scalability
+ */
+PRIVATE void bench_core_read_mostly_scaling(void)
+{
+	spinlock_init(&bench_rm_spinlock);
+	rwlock_init(&bench_rm_rwlock);
+	seqlock_init(&bench_rm_seqlock);
+
+	for (int ncores = 1; ncores <= CORES_NUM; ncores++)
+	{
+		bench_core_read_mostly("spinlock-read-mostly", bench_rm_spinlock_op, ncores);
+		bench_core_read_mostly("rwlock-read-mostly", bench_rm_rwlock_op, ncores);
+		bench_core_read_mostly("seqlock-read-mostly", bench_rm_seqlock_op, ncores);
+	}
+}
+
+/**
+ * @brief Benchmark: Slave Core, Start entry point.
+ */
+PRIVATE void bench_core_start_slave_entry(void)
+{
+	bench_core_started++;
+	dcache_invalidate();
+}
+
+/**
+ * @brief Benchmark: Start a Slave Core
+ *
+ * Measures the time from core_start() until the start routine runs
+ * in the slave core. If the slave has not yet gone back to idle from
+ * a previous iteration, core_start() is issued again.
+ */
+PRIVATE void bench_core_start(int coreid)
+{
+	int last;
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		dcache_invalidate();
+		last = bench_core_started;
+
+		t0 = bench_cycles();
+
+			do
+			{
+				core_start(coreid, bench_core_start_slave_entry);
+				dcache_invalidate();
+			} while (bench_core_started == last);
+
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("core-start", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Slave Core, Suspend/Resume entry point.
+ */
+PRIVATE void bench_core_wakeup_slave_entry(void)
+{
+	bench_core_awaken = -1;
+	dcache_invalidate();
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		core_sleep();
+
+		bench_core_awaken = i;
+		dcache_invalidate();
+	}
+}
+
+/**
+ * @brief Benchmark: Wakeup a Slave Core
+ *
+ * Measures the time from core_wakeup() until the slave core resumes
+ * execution.
+ */
+PRIVATE void bench_core_wakeup(int coreid)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	bench_core_awaken = -2;
+	dcache_invalidate();
+
+	/* Wait for the slave to be idle. */
+	do
+	{
+		core_start(coreid, bench_core_wakeup_slave_entry);
+		dcache_invalidate();
+	} while (bench_core_awaken == -2);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+
+			core_wakeup(coreid);
+
+			do
+				dcache_invalidate();
+			while (bench_core_awaken < i);
+
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("core-wakeup", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Slave Core, Ping-Pong entry point.
+ */
+PRIVATE void bench_core_pingpong_slave_entry(void)
+{
+	bench_core_awaken = -1;
+	hal_wmb();
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		core_sleep();
+		core_wakeup(COREID_MASTER);
+	}
+}
+
+/**
+ * @brief Benchmark: Sleep/Wakeup Ping-Pong
+ *
+ * Measures the round trip of a wakeup signal sent from the master
+ * core to a sleeping slave core, which answers with a wakeup signal
+ * to the master core. Unlike core-wakeup, both cores block in
+ * core_sleep(), so only the HAL signaling path is measured.
+ */
+PRIVATE void bench_core_pingpong(int coreid)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	bench_core_awaken = -2;
+	hal_wmb();
+
+	/* Wait for the slave to be idle. */
+	do
+	{
+		core_start(coreid, bench_core_pingpong_slave_entry);
+		hal_rmb();
+	} while (bench_core_awaken == -2);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+
+			core_wakeup(coreid);
+			core_sleep();
+
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("core-wakeup-pingpong", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * The bench_core() function launches benchmarks on the core
+ * interface of the HAL.
+ */
+PUBLIC void bench_core(void)
+{
+	bench_core_spinlock();
+	bench_core_ticketlock();
+	bench_core_qspinlock();
+	bench_core_read_mostly_scaling();
+
+	/* Benchmarks not applicable. */
+	if (!CLUSTER_IS_MULTICORE)
+		return;
+
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		if (i != COREID_MASTER)
+		{
+			bench_core_start(i);
+			bench_core_wakeup(i);
+			bench_core_pingpong(i);
+			bench_core_contended_locks(i);
+			break;
+		}
+	}
+}
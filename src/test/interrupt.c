@@ -350,3 +350,112 @@ PUBLIC void test_interrupt(void)
 	}
 }
 
+/*============================================================================*
+ * Benchmarks                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Clock frequency.
+ */
+#define BENCH_CLOCK_FREQ 100
+
+/**
+ * @brief Benchmark: Timestamp taken by the interrupt handler.
+ */
+PRIVATE unsigned bench_irq_cycles = 0;
+
+/**
+ * @brief Benchmark: Was an interrupt taken?
+ */
+PRIVATE int bench_irq_taken = 0;
+
+/**
+ * @brief Benchmark: Interrupt handler.
+ */
+PRIVATE void bench_interrupt_handler(int num)
+{
+	UNUSED(num);
+
+	bench_irq_cycles = bench_cycles();
+	bench_irq_taken = 1;
+	dcache_invalidate();
+}
+
+/**
+ * @brief Benchmark: Register an Interrupt Handler
+ */
+PRIVATE void bench_interrupt_register(void)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			KASSERT(interrupt_register(INTERRUPT_CLOCK, dummy_handler) == 0);
+		t1 = bench_cycles();
+
+		KASSERT(interrupt_unregister(INTERRUPT_CLOCK) == 0);
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("interrupt-register", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Interrupt Entry
+ *
+ * Measures the time from the last instruction observed before a
+ * clock interrupt is taken until its handler is called. Samples
+ * that fall across a wrap of the cycle counter are discarded.
+ */
+PRIVATE void bench_interrupt_entry(void)
+{
+	int n = 0;
+	unsigned last;
+	unsigned samples[BENCH_NITERATIONS];
+
+	clock_init(BENCH_CLOCK_FREQ);
+
+	KASSERT(interrupt_register(INTERRUPT_CLOCK, bench_interrupt_handler) == 0);
+
+	interrupts_enable();
+	interrupt_unmask(INTERRUPT_CLOCK);
+
+		for (int i = 0; i < 2*BENCH_NITERATIONS; i++)
+		{
+			bench_irq_taken = 0;
+			dcache_invalidate();
+
+			do
+			{
+				last = bench_cycles();
+				dcache_invalidate();
+			} while (!bench_irq_taken);
+
+			if (bench_irq_cycles > last)
+			{
+				samples[n++] = bench_irq_cycles - last;
+				if (n == BENCH_NITERATIONS)
+					break;
+			}
+		}
+
+	interrupt_mask(INTERRUPT_CLOCK);
+	interrupts_disable();
+
+	KASSERT(interrupt_unregister(INTERRUPT_CLOCK) == 0);
+
+	bench_report("interrupt-entry", samples, n);
+}
+
+/**
+ * The bench_interrupt() function launches benchmarks on the
+ * Interrupt Interface of the HAL.
+ */
+PUBLIC void bench_interrupt(void)
+{
+	bench_interrupt_register();
+	bench_interrupt_entry();
+}
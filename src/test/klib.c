@@ -0,0 +1,434 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2019 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/hal.h>
+#include <nanvix/const.h>
+#include <nanvix/klib.h>
+#include "test.h"
+
+/**
+ * @brief Size of test buffers (in bytes).
+ */
+#define TEST_KLIB_BUFFER_SIZE 4096
+
+/**
+ * @brief Test buffers.
+ */
+/**@{*/
+PRIVATE unsigned char buf1[TEST_KLIB_BUFFER_SIZE + 2*sizeof(kword_t)] ALIGN(sizeof(kword_t));
+PRIVATE unsigned char buf2[TEST_KLIB_BUFFER_SIZE + 2*sizeof(kword_t)] ALIGN(sizeof(kword_t));
+/**@}*/
+
+/**
+ * @brief Division test vectors.
+ */
+PRIVATE const struct
+{
+	uint64_t num;  /**< Dividend.  */
+	uint64_t den;  /**< Divisor.   */
+	uint64_t quot; /**< Quotient.  */
+	uint64_t rem;  /**< Remainder. */
+} test_klib_div_vectors[] = {
+	{ 0x0000000000000000ULL, 0x0000000000000001ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+	{ 0x0000000000000001ULL, 0x0000000000000001ULL, 0x0000000000000001ULL, 0x0000000000000000ULL },
+	{ 0x00007048860ddf79ULL, 0x00000000000003e8ULL, 0x0000001cbe991a14ULL, 0x0000000000000159ULL },
+	{ 0xffffffffffffffffULL, 0x0000000000000003ULL, 0x5555555555555555ULL, 0x0000000000000000ULL },
+	{ 0xffffffffffffffffULL, 0xffffffffffffffffULL, 0x0000000000000001ULL, 0x0000000000000000ULL },
+	{ 0x8000000000000000ULL, 0x0000000000000020ULL, 0x0400000000000000ULL, 0x0000000000000000ULL },
+	{ 0x123456789abcdef0ULL, 0x000000000000000aULL, 0x01d208a5a912e318ULL, 0x0000000000000000ULL },
+	{ 0x000000e8d4a51000ULL, 0x000000003b9aca07ULL, 0x00000000000003e7ULL, 0x000000003b9aaeafULL },
+	{ 0xfedcba9876543210ULL, 0x0000000001234567ULL, 0x000000e0000069e0ULL, 0x00000000000038f0ULL },
+	{ 0x0000000000000063ULL, 0x0000000000000064ULL, 0x0000000000000000ULL, 0x0000000000000063ULL },
+	{ 0x8000000000000000ULL, 0x7fffffffffffffffULL, 0x0000000000000001ULL, 0x0000000000000001ULL },
+	{ 0x0000000100000000ULL, 0x00000000ffffffffULL, 0x0000000000000001ULL, 0x0000000000000001ULL },
+	{ 0x00000000ee6b2800ULL, 0x0000000000000007ULL, 0x00000000220f4edbULL, 0x0000000000000003ULL },
+};
+
+/**
+ * @brief Number of division test vectors.
+ */
+#define TEST_KLIB_DIV_NVECTORS \
+	(sizeof(test_klib_div_vectors)/sizeof(test_klib_div_vectors[0]))
+
+/**
+ * @brief Fills a buffer with a known pattern.
+ *
+ * @param buf Target buffer.
+ * @param n   Number of bytes to fill.
+ */
+PRIVATE void test_klib_fill(unsigned char *buf, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		buf[i] = (unsigned char) ((i*7 + 1) & 0xff);
+}
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Copy Memory
+ */
+PRIVATE void test_klib_kmemcpy(void)
+{
+	const size_t len = 4*KWORD_SIZE*4 + 3;
+
+	for (size_t doff = 0; doff < KWORD_SIZE; doff++)
+	{
+		for (size_t soff = 0; soff < KWORD_SIZE; soff++)
+		{
+			for (size_t n = 0; n <= len; n++)
+			{
+				test_klib_fill(buf1, len + 2*KWORD_SIZE);
+				kmemset(buf2, 0, len + 2*KWORD_SIZE);
+
+				KASSERT(kmemcpy(&buf2[doff], &buf1[soff], n) == &buf2[doff]);
+
+				/* Check copied bytes and boundaries. */
+				for (size_t i = 0; i < doff; i++)
+					KASSERT(buf2[i] == 0);
+				for (size_t i = 0; i < n; i++)
+					KASSERT(buf2[doff + i] == buf1[soff + i]);
+				KASSERT(buf2[doff + n] == 0);
+			}
+		}
+	}
+}
+
+/**
+ * @brief API Test: Fill Memory
+ */
+PRIVATE void test_klib_kmemset(void)
+{
+	const size_t len = 4*KWORD_SIZE*4 + 3;
+
+	for (size_t off = 0; off < KWORD_SIZE; off++)
+	{
+		for (size_t n = 0; n <= len; n++)
+		{
+			kmemset(buf1, 0, len + 2*KWORD_SIZE);
+
+			KASSERT(kmemset(&buf1[off], 0xa5, n) == &buf1[off]);
+
+			/* Check filled bytes and boundaries. */
+			for (size_t i = 0; i < off; i++)
+				KASSERT(buf1[i] == 0);
+			for (size_t i = 0; i < n; i++)
+				KASSERT(buf1[off + i] == 0xa5);
+			KASSERT(buf1[off + n] == 0);
+		}
+	}
+}
+
+/**
+ * @brief API Test: Move Memory
+ */
+PRIVATE void test_klib_kmemmove(void)
+{
+	const size_t len = 4*KWORD_SIZE*4 + 3;
+
+	for (size_t doff = 0; doff < 2*KWORD_SIZE; doff++)
+	{
+		for (size_t soff = 0; soff < 2*KWORD_SIZE; soff++)
+		{
+			test_klib_fill(buf1, len + 2*KWORD_SIZE);
+			test_klib_fill(buf2, len + 2*KWORD_SIZE);
+
+			/* Overlapping areas. */
+			KASSERT(kmemmove(&buf1[doff], &buf1[soff], len) == &buf1[doff]);
+
+			for (size_t i = 0; i < len; i++)
+				KASSERT(buf1[doff + i] == buf2[soff + i]);
+		}
+	}
+}
+
+/**
+ * @brief API Test: Divide Numbers
+ *
+ * Operands go through volatile variables, so that divisions are not
+ * folded at compile time and reach the division runtime instead.
+ */
+PRIVATE void test_klib_division(void)
+{
+	volatile uint64_t n64, d64;
+	volatile uint32_t n32, d32;
+	volatile int64_t s64;
+	volatile int32_t s32;
+
+	for (size_t i = 0; i < TEST_KLIB_DIV_NVECTORS; i++)
+	{
+		n64 = test_klib_div_vectors[i].num;
+		d64 = test_klib_div_vectors[i].den;
+
+		/* 64-bit unsigned. */
+		KASSERT((n64 / d64) == test_klib_div_vectors[i].quot);
+		KASSERT((n64 % d64) == test_klib_div_vectors[i].rem);
+
+		/* 32-bit unsigned. */
+		if (((n64 >> 32) == 0) && ((d64 >> 32) == 0))
+		{
+			n32 = (uint32_t) n64;
+			d32 = (uint32_t) d64;
+			KASSERT((n32 / d32) == test_klib_div_vectors[i].quot);
+			KASSERT((n32 % d32) == test_klib_div_vectors[i].rem);
+		}
+	}
+
+	/* Signed, rounding towards zero. */
+	s32 = -7;
+	KASSERT((s32 / 2) == -3);
+	KASSERT((s32 % 2) == -1);
+	KASSERT((s32 / -2) == 3);
+	s64 = -7000000000LL;
+	KASSERT((s64 / 3) == -2333333333LL);
+	KASSERT((s64 % 3) == -1);
+	KASSERT((s64 / -1000) == 7000000);
+}
+
+/**
+ * @brief API Test: Log Messages
+ *
+ * Logs a message with klog(), and checks that the record read back
+ * from the HAL log is formatted as it would be output when drained.
+ */
+PRIVATE void test_klib_klog(void)
+{
+	int len;
+	size_t n;
+	char line[2*KBUFFER_SIZE];
+	const char *expected = "[test] klog 42 0x0000beef str -1\n";
+
+	/* Output pending records. */
+	hal_log_drain();
+
+	klog("[test] klog %d %x %s %d", 42, 0xbeef, "str", -1);
+
+	n = kstrlen(expected);
+	KASSERT((len = hal_log_read(line, sizeof(line))) > 0);
+	KASSERT(kstrncmp(line, "[core ", 6) == 0);
+	KASSERT((size_t) len > n);
+	KASSERT(kstrncmp(&line[len - n], expected, n) == 0);
+
+	/* No records left. */
+	KASSERT(hal_log_read(line, sizeof(line)) == 0);
+}
+
+/*============================================================================*
+ * Benchmarks                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Memory Routine
+ *
+ * @param name Name of the benchmark.
+ * @param fn   Routine to benchmark.
+ * @param n    Number of bytes to process.
+ */
+PRIVATE void bench_klib_run(
+	const char *name,
+	void (*fn)(size_t),
+	size_t n
+)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			fn(n);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report(name, samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Copy Memory
+ *
+ * @param n Number of bytes to copy.
+ */
+PRIVATE void bench_klib_kmemcpy(size_t n)
+{
+	kmemcpy(buf2, buf1, n);
+}
+
+/**
+ * @brief Benchmark: Copy Memory with Cache Maintenance
+ *
+ * @param n Number of bytes to copy.
+ */
+PRIVATE void bench_klib_kmemcpy_coherent(size_t n)
+{
+	kmemcpy_coherent(buf2, buf1, n);
+}
+
+/**
+ * @brief Benchmark: Move Memory (overlapping areas)
+ *
+ * @param n Number of bytes to move.
+ */
+PRIVATE void bench_klib_kmemmove(size_t n)
+{
+	kmemmove(&buf1[sizeof(kword_t)], buf1, n);
+}
+
+/**
+ * @brief Benchmark: Fill Memory
+ *
+ * @param n Number of bytes to fill.
+ */
+PRIVATE void bench_klib_kmemset(size_t n)
+{
+	kmemset(buf2, 0, n);
+}
+
+/**
+ * @brief Benchmark: Logging
+ *
+ * Compares the cost of a deferred klog() call against a kprintf()
+ * call with the same message. Logs are drained before each run, so
+ * klog() records never overflow.
+ */
+PRIVATE void bench_klib_log(void)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	hal_log_drain();
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			klog("[bench] log %d", i);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	hal_log_drain();
+	bench_report("klog", samples, BENCH_NITERATIONS);
+	hal_log_drain();
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			kprintf("[bench] log %d", i);
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	hal_log_drain();
+	bench_report("kprintf", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * @brief Benchmark: Division
+ *
+ * Measures the cost of a 32-bit and of a 64-bit unsigned division
+ * with operands that take the general path of the division runtime.
+ */
+PRIVATE void bench_klib_division(void)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+	volatile uint64_t n64 = 0xfedcba9876543210ULL, d64 = 0x1234567ULL, q64;
+	volatile uint32_t n32 = 0xfedcba98, d32 = 0x1234567, q32;
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			q32 = n32 / d32;
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("udivsi3", samples, BENCH_NITERATIONS);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			q64 = n64 / d64;
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("udivdi3", samples, BENCH_NITERATIONS);
+
+	UNUSED(q32);
+	UNUSED(q64);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test klib_api_tests[] = {
+	{ test_klib_kmemcpy,   "Copy Memory"    },
+	{ test_klib_kmemset,   "Fill Memory"    },
+	{ test_klib_kmemmove,  "Move Memory"    },
+	{ test_klib_division,  "Divide Numbers" },
+	{ test_klib_klog,      "Log Messages"   },
+	{ NULL,                NULL             },
+};
+
+/**
+ * The test_klib() function launches testing units on the memory and
+ * arithmetic routines of the kernel library.
+ */
+PUBLIC void test_klib(void)
+{
+	for (int i = 0; klib_api_tests[i].test_fn != NULL; i++)
+	{
+		klib_api_tests[i].test_fn();
+		kprintf("[test][api][klib] %s [passed]", klib_api_tests[i].name);
+	}
+}
+
+/**
+ * The bench_klib() function launches benchmarks on the memory and
+ * arithmetic routines of the kernel library.
+ */
+PUBLIC void bench_klib(void)
+{
+	bench_klib_run("kmemcpy-64", bench_klib_kmemcpy, 64);
+	bench_klib_run("kmemcpy-512", bench_klib_kmemcpy, 512);
+	bench_klib_run("kmemcpy-4096", bench_klib_kmemcpy, TEST_KLIB_BUFFER_SIZE);
+	bench_klib_run("kmemcpy-coherent-4096", bench_klib_kmemcpy_coherent, TEST_KLIB_BUFFER_SIZE);
+	bench_klib_run("kmemmove-4096", bench_klib_kmemmove, TEST_KLIB_BUFFER_SIZE);
+	bench_klib_run("kmemset-64", bench_klib_kmemset, 64);
+	bench_klib_run("kmemset-512", bench_klib_kmemset, 512);
+	bench_klib_run("kmemset-4096", bench_klib_kmemset, TEST_KLIB_BUFFER_SIZE);
+	bench_klib_log();
+	bench_klib_division();
+}
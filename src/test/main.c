@@ -37,7 +37,10 @@ PUBLIC int main(int argc, const char **argv)
 	UNUSED(argv);
 
 	while (TRUE)
+	{
+		hal_log_drain();
 		noop();
+	}
 }
 
 /**
@@ -54,6 +57,17 @@ PUBLIC void kmain(int argc, const char *argv[])
 	 */
 	hal_init();
 
+#if defined(HAL_BENCHMARK)
+
+	bench_klib();
+	bench_core();
+	bench_trap();
+	bench_upcall();
+	bench_tlb();
+	bench_interrupt();
+
+#else
+
 	test_interrupt();
 	test_exception();
 	test_clock();
@@ -62,11 +76,17 @@ PUBLIC void kmain(int argc, const char *argv[])
 	test_core();
 	test_trap();
 	test_upcall();
+	test_klib();
 
 #if (TARGET_HAS_SYNC)
 	test_sync();
 #endif
 
+#endif
+
+	/* Dump lock statistics, if any. */
+	lockstat_dump();
+
 	kprintf("[hal] halting...");
 
 	main(0, NULL);
@@ -240,3 +240,64 @@ PUBLIC void test_trap(void)
 	}
 }
 
+/*============================================================================*
+ * Benchmarks                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Issue a Trap
+ *
+ * @param nargs Number of arguments.
+ */
+PRIVATE void bench_trap_issue(int nargs)
+{
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+	const char *names[] = {
+		"syscall0", "syscall1", "syscall2",
+		"syscall3", "syscall4", "syscall5"
+	};
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+
+			switch (nargs)
+			{
+				case 0:
+					syscall0(SYSCALL0_NR);
+					break;
+				case 1:
+					syscall1(SYSCALL1_NR, MAGIC0);
+					break;
+				case 2:
+					syscall2(SYSCALL2_NR, MAGIC0, MAGIC1);
+					break;
+				case 3:
+					syscall3(SYSCALL3_NR, MAGIC0, MAGIC1, MAGIC2);
+					break;
+				case 4:
+					syscall4(SYSCALL4_NR, MAGIC0, MAGIC1, MAGIC2, MAGIC3);
+					break;
+				default:
+					syscall5(SYSCALL5_NR, MAGIC0, MAGIC1, MAGIC2, MAGIC3, MAGIC4);
+					break;
+			}
+
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report(names[nargs], samples, BENCH_NITERATIONS);
+}
+
+/**
+ * The bench_trap() function launches benchmarks on the trap
+ * interface of the HAL.
+ */
+PUBLIC void bench_trap(void)
+{
+	for (int nargs = 0; nargs <= 5; nargs++)
+		bench_trap_issue(nargs);
+}
@@ -44,6 +44,11 @@
 	 */
 	EXTERN void test_core(void);
 
+	/**
+	 * @brief Test driver for the Kernel Library.
+	 */
+	EXTERN void test_klib(void);
+
 	/**
 	 * @brief Test driver for the Sync Interface
 	 */
@@ -79,4 +84,62 @@
 	 */
 	EXTERN void test_mmu(void);
 
+/*============================================================================*
+ * Benchmarks                                                                 *
+ *============================================================================*/
+
+	/**
+	 * @brief Number of iterations for benchmarks.
+	 */
+	#define BENCH_NITERATIONS 32
+
+	/**
+	 * @brief Reads a free-running cycle counter.
+	 *
+	 * @returns The lower bits of a free-running cycle counter.
+	 */
+	static inline unsigned bench_cycles(void)
+	{
+		return ((unsigned) clock_read_cycles());
+	}
+
+	/**
+	 * @brief Prints the results of a benchmark.
+	 *
+	 * @param name    Name of the benchmark.
+	 * @param samples Samples (in cycles).
+	 * @param n       Number of samples.
+	 */
+	EXTERN void bench_report(const char *name, unsigned *samples, int n);
+
+	/**
+	 * @brief Benchmark driver for the Core Interface.
+	 */
+	EXTERN void bench_core(void);
+
+	/**
+	 * @brief Benchmark driver for the Hardware Interrupt Interface.
+	 */
+	EXTERN void bench_interrupt(void);
+
+	/**
+	 * @brief Benchmark driver for the Kernel Library.
+	 */
+	EXTERN void bench_klib(void);
+
+	/**
+	 * @brief Benchmark driver for the TLB Interface.
+	 */
+	EXTERN void bench_tlb(void);
+
+	/**
+	 * @brief Benchmark driver for the Trap Interface.
+	 */
+	EXTERN void bench_trap(void);
+
+	/**
+	 * @brief Benchmark driver for the Upcall Interface.
+	 */
+	EXTERN void bench_upcall(void);
+
 #endif /* _HAL_TEST_H_ */
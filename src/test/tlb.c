@@ -180,6 +180,317 @@ PRIVATE void test_tlb_write_destructive(void)
 	KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr) == NULL);
 }
 
+/*----------------------------------------------------------------------------*
+ * Synchronize an Entry of the TLB                                            *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Synchronize an Entry of the TLB
+ */
+PRIVATE void test_tlb_sync_entry(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(_UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_sync_entry() vaddr = %x, paddr = %x", vaddr, paddr);
+#endif
+
+	/* Write TLB entry. */
+	KASSERT(tlb_write(TLB_DATA, vaddr, paddr) == 0);
+	KASSERT(tlb_sync_entry(TLB_DATA, vaddr) == 0);
+
+	/* This entry should exist. */
+	KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr) != NULL);
+
+	/* Invalidate TLB entry. */
+	KASSERT(tlb_inval(TLB_DATA, vaddr) == 0);
+	KASSERT(tlb_sync_entry(TLB_DATA, vaddr) == 0);
+
+	/* This entry should no longer exist. */
+	KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr) == NULL);
+
+	/* Nothing else should be pending. */
+	KASSERT(tlb_flush() == 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Write and Invalidate a Range of the TLB                                    *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Number of pages used in range tests.
+ */
+#define TEST_TLB_RANGE_NPAGES 4
+
+/**
+ * @brief API Test: Write and Invalidate a Range of the TLB
+ */
+PRIVATE void test_tlb_range(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(_UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_write_range() vaddr = %x, paddr = %x", vaddr, paddr);
+#endif
+
+	/* Write TLB entries. */
+	KASSERT(tlb_write_range(TLB_DATA, vaddr, paddr, TEST_TLB_RANGE_NPAGES) == 0);
+	KASSERT(tlb_flush() == 0);
+
+	/* These entries should exist. */
+	for (int i = 0; i < TEST_TLB_RANGE_NPAGES; i++)
+		KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) != NULL);
+
+	/* Invalidate TLB entries. */
+	KASSERT(tlb_inval_range(TLB_DATA, vaddr, TEST_TLB_RANGE_NPAGES) == 0);
+	KASSERT(tlb_flush() == 0);
+
+	/* These entries should no longer exist. */
+	for (int i = 0; i < TEST_TLB_RANGE_NPAGES; i++)
+		KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) == NULL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Commit a Batch of TLB Operations                                           *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Commit a Batch of TLB Operations
+ */
+PRIVATE void test_tlb_batch(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+	struct tlb_batch batch;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(_UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_batch_write() vaddr = %x, paddr = %x", vaddr, paddr);
+#endif
+
+	tlb_batch_init(&batch);
+
+	/* Contiguous writes should be merged. */
+	for (int i = 0; i < TEST_TLB_RANGE_NPAGES; i++)
+		KASSERT(tlb_batch_write(&batch, TLB_DATA, vaddr + i*PAGE_SIZE, paddr + i*PAGE_SIZE, 1) == 0);
+	KASSERT(batch.nops == 1);
+	KASSERT(tlb_batch_commit(&batch) == 0);
+
+	/* These entries should exist. */
+	for (int i = 0; i < TEST_TLB_RANGE_NPAGES; i++)
+		KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) != NULL);
+
+	/* Invalidate TLB entries. */
+	KASSERT(tlb_batch_inval(&batch, TLB_DATA, vaddr, TEST_TLB_RANGE_NPAGES) == 0);
+	KASSERT(tlb_batch_commit(&batch) == 0);
+
+	/* These entries should no longer exist. */
+	for (int i = 0; i < TEST_TLB_RANGE_NPAGES; i++)
+		KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) == NULL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Shootdown a Range of the TLB                                               *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Shootdown a Range of the TLB
+ */
+PRIVATE void test_tlb_shootdown(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+	struct tlb_shootdown_token token;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(_UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_shootdown() vaddr = %x", vaddr);
+#endif
+
+	/* Write TLB entries. */
+	KASSERT(tlb_write_range(TLB_DATA, vaddr, paddr, TEST_TLB_RANGE_NPAGES) == 0);
+	KASSERT(tlb_flush() == 0);
+
+	/* Shootdown first page in the calling core. */
+	KASSERT(tlb_shootdown(1u << core_get_id(), vaddr, 1) == 0);
+	KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr) == NULL);
+
+	/* Local shootdowns need no acknowledgment. */
+	KASSERT(tlb_shootdown_post(1u << core_get_id(), vaddr, TEST_TLB_RANGE_NPAGES, &token) == 0);
+	KASSERT(tlb_shootdown_done(&token));
+
+	/* These entries should no longer exist. */
+	for (int i = 0; i < TEST_TLB_RANGE_NPAGES; i++)
+		KASSERT(tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) == NULL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Shootdown a Range of the TLB in a Slave Core                               *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Entries found by the slave core.
+ */
+PRIVATE volatile int test_tlb_shootdown_found = 0;
+
+/**
+ * @brief API Test: Is the slave core done?
+ */
+PRIVATE volatile int test_tlb_shootdown_done = 0;
+
+/**
+ * @brief API Test: Counts shootdown entries in the TLB of the calling core.
+ */
+PRIVATE void test_tlb_shootdown_count(void)
+{
+	vaddr_t vaddr;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+
+	test_tlb_shootdown_found = 0;
+	for (int i = 0; i < TEST_TLB_RANGE_NPAGES; i++)
+	{
+		if (tlb_lookup_vaddr(TLB_DATA, vaddr + i*PAGE_SIZE) != NULL)
+			test_tlb_shootdown_found++;
+	}
+
+	test_tlb_shootdown_done = 1;
+	dcache_invalidate();
+}
+
+/**
+ * @brief API Test: Slave Core, writes shootdown entries in its TLB.
+ */
+PRIVATE void test_tlb_shootdown_fill_entry(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(_UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+	tlb_write_range(TLB_DATA, vaddr, paddr, TEST_TLB_RANGE_NPAGES);
+	tlb_flush();
+
+	test_tlb_shootdown_count();
+}
+
+/**
+ * @brief API Test: Runs a function in a slave core and waits for it.
+ *
+ * @param coreid ID of the target slave core.
+ * @param start  Function to run. It should set test_tlb_shootdown_done.
+ */
+PRIVATE void test_tlb_shootdown_run(int coreid, void (*start)(void))
+{
+	test_tlb_shootdown_done = 0;
+	dcache_invalidate();
+
+	/*
+	 * The slave core may still be
+	 * finishing a previous test, so retry.
+	 */
+	do
+	{
+		core_start(coreid, start);
+		dcache_invalidate();
+	} while (!test_tlb_shootdown_done);
+}
+
+/**
+ * @brief API Test: Shootdown a Range of the TLB in a Slave Core
+ *
+ * The slave core writes entries in its TLB and goes back to idle.
+ * The master core then shoots them down, and the slave core should
+ * acknowledge it without being started again.
+ */
+PRIVATE void test_tlb_shootdown_slave(void)
+{
+	int coreid = -1;
+	vaddr_t vaddr;
+	struct tlb_shootdown_token token;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+
+	for (int i = 0; i < CORES_NUM; i++)
+	{
+		if (i != core_get_id())
+		{
+			coreid = i;
+			break;
+		}
+	}
+
+	/* No slave core. */
+	if (!CLUSTER_IS_MULTICORE || (coreid < 0))
+		return;
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_shootdown() coreid = %d vaddr = %x", coreid, vaddr);
+#endif
+
+	test_tlb_shootdown_run(coreid, test_tlb_shootdown_fill_entry);
+	KASSERT(test_tlb_shootdown_found == TEST_TLB_RANGE_NPAGES);
+
+	/* Shootdown range in the slave core. */
+	KASSERT(tlb_shootdown_post(1u << coreid, vaddr, TEST_TLB_RANGE_NPAGES, &token) == 0);
+	KASSERT(token.coremask == (1u << coreid));
+	tlb_shootdown_wait(&token);
+	KASSERT(tlb_shootdown_done(&token));
+
+	/* These entries should no longer exist. */
+	test_tlb_shootdown_run(coreid, test_tlb_shootdown_count);
+	KASSERT(test_tlb_shootdown_found == 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Switch Address Space Identifiers                                           *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Switch Address Space Identifiers
+ */
+PRIVATE void test_tlb_switch_asid(void)
+{
+	uint32_t id;
+	struct tlb_asid asid1;
+	struct tlb_asid asid2;
+
+	tlb_asid_init(&asid1);
+	tlb_asid_init(&asid2);
+
+	/* ASIDs are assigned on first switch. */
+	KASSERT(tlb_switch_asid(&asid1) == 0);
+	KASSERT(tlb_switch_asid(&asid2) == 0);
+	KASSERT(asid1.id != 0);
+	KASSERT(asid2.id != 0);
+	KASSERT(asid1.id != asid2.id);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_switch_asid() asid1 = %x, asid2 = %x", asid1.id, asid2.id);
+#endif
+
+	/* ASIDs are kept across switches. */
+	id = asid1.id;
+	KASSERT(tlb_switch_asid(&asid1) == 0);
+	KASSERT(asid1.id == id);
+
+	/* Back to kernel ASID. */
+	KASSERT(tlb_asid_set(0) == 0);
+}
+
 /*----------------------------------------------------------------------------*
  * Test Driver Table                                                          *
  *----------------------------------------------------------------------------*/
@@ -193,6 +504,12 @@ PRIVATE struct test tlb_api_tests[] = {
 	{ test_tlb_write,             "write"                   },
 	{ test_tlb_invalidate,        "invalidate"              },
 	{ test_tlb_write_destructive, "write destructive"       },
+	{ test_tlb_sync_entry,        "sync entry"              },
+	{ test_tlb_range,             "range"                   },
+	{ test_tlb_batch,             "batch"                   },
+	{ test_tlb_shootdown,         "shootdown"               },
+	{ test_tlb_shootdown_slave,   "shootdown slave"         },
+	{ test_tlb_switch_asid,       "switch asid"             },
 	{ NULL,                        NULL                     },
 };
 
@@ -336,6 +653,70 @@ PRIVATE void test_tlb_invalidate_inval(void)
 	 */
 }
 
+/*----------------------------------------------------------------------------*
+ * Synchronize an Invalid TLB Entry                                           *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Synchronize an Invalid TLB Entry
+ */
+PRIVATE void test_tlb_sync_entry_inval(void)
+{
+	vaddr_t vaddr;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_sync_entry() vaddr = %x", vaddr);
+#endif
+
+	KASSERT(tlb_sync_entry(-1, vaddr) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Batch an Invalid TLB Operation                                             *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Batch an Invalid TLB Operation
+ */
+PRIVATE void test_tlb_batch_inval(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+	struct tlb_batch batch;
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(_UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+#if (TEST_TLB_VERBOSE)
+	kprintf("tlb_batch_write() vaddr = %x, paddr = %x", vaddr, paddr);
+#endif
+
+	tlb_batch_init(&batch);
+
+	KASSERT(tlb_write_range(-1, vaddr, paddr, 1) == -EINVAL);
+	KASSERT(tlb_inval_range(-1, vaddr, 1) == -EINVAL);
+	KASSERT(tlb_batch_write(&batch, -1, vaddr, paddr, 1) == -EINVAL);
+	KASSERT(tlb_batch_inval(&batch, -1, vaddr, 1) == -EINVAL);
+	KASSERT(tlb_batch_commit(NULL) == -EINVAL);
+	KASSERT(batch.nops == 0);
+	KASSERT(tlb_shootdown_post(1u << core_get_id(), vaddr, 1, NULL) == -EINVAL);
+}
+
+/*----------------------------------------------------------------------------*
+ * Switch to an Invalid Address Space Identifier                              *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Fault Injection Test: Switch to an Invalid Address Space Identifier
+ */
+PRIVATE void test_tlb_switch_asid_inval(void)
+{
+	KASSERT(tlb_switch_asid(NULL) == -EINVAL);
+	KASSERT(tlb_asid_set(1u << TLB_ASID_BITS) == -EINVAL);
+}
+
 /*----------------------------------------------------------------------------*
  * Test Driver Table                                                          *
  *----------------------------------------------------------------------------*/
@@ -350,6 +731,9 @@ PRIVATE struct test tlb_fault_tests[] = {
 	{ test_tlb_lookup_paddr_bad,            "lookup bad physical address"     },
 	{ test_tlb_write_inval,                 "write invalid entry"             },
 	{ test_tlb_invalidate_inval,            "invalidate invalid entry"        },
+	{ test_tlb_sync_entry_inval,            "sync invalid entry"              },
+	{ test_tlb_batch_inval,                 "batch invalid operation"         },
+	{ test_tlb_switch_asid_inval,           "switch invalid asid"             },
 	{ NULL,                                  NULL                             },
 };
 
@@ -383,3 +767,137 @@ PUBLIC void test_tlb(void)
 	}
 }
 
+/*============================================================================*
+ * Benchmarks                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Write, Invalidate and Flush TLB Entries
+ */
+PRIVATE void bench_tlb_write_inval_flush(void)
+{
+	vaddr_t vaddr;
+	paddr_t paddr;
+	unsigned t0, t1;
+	unsigned samples_write[BENCH_NITERATIONS];
+	unsigned samples_inval[BENCH_NITERATIONS];
+	unsigned samples_flush[BENCH_NITERATIONS];
+
+	vaddr = TRUNCATE(VADDR(_UBASE_VIRT) + PAGE_SIZE, PAGE_SIZE);
+	paddr = TRUNCATE(PADDR(_UBASE_PHYS) + PAGE_SIZE, PAGE_SIZE);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		t0 = bench_cycles();
+			KASSERT(tlb_write(TLB_DATA, vaddr, paddr) == 0);
+		t1 = bench_cycles();
+		samples_write[i] = t1 - t0;
+
+		t0 = bench_cycles();
+			KASSERT(tlb_inval(TLB_DATA, vaddr) == 0);
+		t1 = bench_cycles();
+		samples_inval[i] = t1 - t0;
+
+		t0 = bench_cycles();
+			KASSERT(tlb_flush() == 0);
+		t1 = bench_cycles();
+		samples_flush[i] = t1 - t0;
+	}
+
+	bench_report("tlb-write", samples_write, BENCH_NITERATIONS);
+	bench_report("tlb-inval", samples_inval, BENCH_NITERATIONS);
+	bench_report("tlb-flush", samples_flush, BENCH_NITERATIONS);
+}
+
+#if defined(__or1k__)
+
+/**
+ * @brief Benchmark: Page used to force TLB misses.
+ */
+PRIVATE char bench_tlb_page[PAGE_SIZE] ALIGN(PAGE_SIZE);
+
+#endif
+
+/**
+ * @brief Benchmark: Refill the TLB on a Miss
+ *
+ * Measures the time taken to access a page whose TLB entry was
+ * invalidated, thus including the cost of the TLB miss handler.
+ */
+PRIVATE void bench_tlb_refill(void)
+{
+#if defined(__or1k__)
+	vaddr_t vaddr;
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	vaddr = VADDR(bench_tlb_page);
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		KASSERT(tlb_inval(TLB_DATA, vaddr) == 0);
+		KASSERT(tlb_flush() == 0);
+
+		t0 = bench_cycles();
+			bench_tlb_page[i] = (char) i;
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("tlb-refill", samples, BENCH_NITERATIONS);
+#endif
+}
+
+/**
+ * @brief Benchmark: Refill the TLB from the Translation Storage Buffer
+ *
+ * Measures the time taken to access a page whose TLB slot was taken
+ * by a conflicting entry, thus the refill is served by the translation
+ * storage buffer, instead of by a page table walk.
+ */
+PRIVATE void bench_tlb_tsb_refill(void)
+{
+#if defined(__or1k__)
+	vaddr_t vaddr;
+	vaddr_t conflict;
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	vaddr = VADDR(bench_tlb_page);
+	conflict = vaddr + OR1K_TLB_LENGTH*PAGE_SIZE;
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		KASSERT(tlb_write(TLB_DATA, conflict, PADDR(vaddr)) == 0);
+		KASSERT(tlb_flush() == 0);
+
+		t0 = bench_cycles();
+			bench_tlb_page[i] = (char) i;
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	KASSERT(tlb_inval(TLB_DATA, conflict) == 0);
+	KASSERT(tlb_flush() == 0);
+
+	bench_report("tlb-tsb-refill", samples, BENCH_NITERATIONS);
+#endif
+}
+
+/**
+ * The bench_tlb() function launches benchmarks on the TLB
+ * Interface of the HAL.
+ */
+PUBLIC void bench_tlb(void)
+{
+	/* Benchmarks not applicable. */
+#ifdef TLB_HARDWARE
+		return;
+#endif
+
+	bench_tlb_write_inval_flush();
+	bench_tlb_refill();
+	bench_tlb_tsb_refill();
+}
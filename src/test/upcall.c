@@ -211,3 +211,56 @@ PUBLIC void test_upcall(void)
 		kprintf("[test][upcall][api] %s [passed]", upcall_tests_api[i].name);
 	}
 }
+
+/*============================================================================*
+ * Benchmarks                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Benchmark: Forge and Issue an Upcall
+ */
+PRIVATE void bench_upcall_issue(void)
+{
+	dword_t arg = MAGIC;
+	unsigned t0, t1;
+	unsigned samples[BENCH_NITERATIONS];
+
+	for (int i = 0; i < BENCH_NITERATIONS; i++)
+	{
+		/* Build fake stack. */
+		kmemset(&fake_stack, 0, FAKE_STACK_SIZE);
+
+		/* Build fake context. */
+		kmemset(&fake_context, 0, sizeof(struct context));
+		for (int j = 0; j < CONTEXT_SIZE/WORD_SIZE; j++)
+			((word_t *)&fake_context)[j] = (word_t) j;
+		context_set_sp(&fake_context, FAKE_STACK_BASE);
+		context_set_pc(&fake_context, ((word_t) &_upcall_issue_ret));
+
+		t0 = bench_cycles();
+
+			upcall_forge(
+				&fake_context,
+				&dumb_upcall,
+				&arg,
+				sizeof(dword_t)
+			);
+
+			_upcall_issue(FAKE_STACK_TOP);
+
+		t1 = bench_cycles();
+
+		samples[i] = t1 - t0;
+	}
+
+	bench_report("upcall-forge-ret", samples, BENCH_NITERATIONS);
+}
+
+/**
+ * The bench_upcall() function launches benchmarks on the upcall
+ * interface of the HAL.
+ */
+PUBLIC void bench_upcall(void)
+{
+	bench_upcall_issue();
+}